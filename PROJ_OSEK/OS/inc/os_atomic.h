@@ -0,0 +1,82 @@
+#ifndef OS_ATOMIC_H
+#define OS_ATOMIC_H
+
+/*
+ * ============================================================
+ *  Atomic helpers (Cortex-M3 – LDREX/STREX)
+ *  - KHÔNG tắt ngắt: exclusive monitor bị xoá mỗi khi vào/ra ngắt,
+ *    nên nếu có ISR chen giữa LDREX và STREX thì STREX trả 1 → thử lại.
+ *  - Trên lõi đơn, vòng lặp chỉ lặp lại khi có ngắt xen vào (bị chặn
+ *    bởi số ngắt lồng nhau) → coi như wait-free trong thực tế.
+ *  - Dùng chung cho log, IOC, pool...
+ * ============================================================
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f10x.h"   /* kéo theo CMSIS: __LDREXW/__STREXW/__CLREX/__DMB */
+
+/* Compare-and-swap 32 bit: ghi 'desired' nếu *p == 'expect' */
+static inline bool os_atomic_cas32(volatile uint32_t *p, uint32_t expect, uint32_t desired)
+{
+    do {
+        if (__LDREXW(p) != expect) {
+            __CLREX();
+            return false;
+        }
+    } while (__STREXW(desired, p) != 0u);
+    return true;
+}
+
+/* *p += v, trả về giá trị MỚI */
+static inline uint32_t os_atomic_add32(volatile uint32_t *p, uint32_t v)
+{
+    uint32_t n;
+    do {
+        n = __LDREXW(p) + v;
+    } while (__STREXW(n, p) != 0u);
+    return n;
+}
+
+/* *p |= v, trả về giá trị CŨ */
+static inline uint32_t os_atomic_or32(volatile uint32_t *p, uint32_t v)
+{
+    uint32_t o;
+    do {
+        o = __LDREXW(p);
+    } while (__STREXW(o | v, p) != 0u);
+    return o;
+}
+
+/* *p &= v, trả về giá trị CŨ */
+static inline uint32_t os_atomic_and32(volatile uint32_t *p, uint32_t v)
+{
+    uint32_t o;
+    do {
+        o = __LDREXW(p);
+    } while (__STREXW(o & v, p) != 0u);
+    return o;
+}
+
+/* Đổi *p = v, trả về giá trị CŨ */
+static inline uint32_t os_atomic_xchg32(volatile uint32_t *p, uint32_t v)
+{
+    uint32_t o;
+    do {
+        o = __LDREXW(p);
+    } while (__STREXW(v, p) != 0u);
+    return o;
+}
+
+/* *p = max(*p, v) – dùng cho thống kê high-water */
+static inline void os_atomic_max32(volatile uint32_t *p, uint32_t v)
+{
+    do {
+        if (__LDREXW(p) >= v) {
+            __CLREX();
+            return;
+        }
+    } while (__STREXW(v, p) != 0u);
+}
+
+#endif /* OS_ATOMIC_H */
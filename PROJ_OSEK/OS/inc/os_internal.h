@@ -0,0 +1,72 @@
+#ifndef OS_INTERNAL_H
+#define OS_INTERNAL_H
+
+/*
+ * =====================================================================
+ *  API nội bộ của kernel (KHÔNG dùng trong ứng dụng)
+ *  - Dành cho các module kernel khác (os_msgq.c, ...) cần chặn/đánh
+ *    thức task mà không đụng trực tiếp vào TCB/READY queue.
+ *  - Mọi hàm ở đây phải được gọi khi IRQ ĐÃ TẮT (__disable_irq).
+ * =====================================================================
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "os_kernel.h"
+
+#if (OS_CFG_EVENTS)
+/* Chèn t vào q theo ưu tiên (cùng ưu tiên → xếp sau, FIFO) */
+void os_waitq_insert(OsWaitQ_t *q, TCB_t *t);
+
+/* Lấy task ưu tiên cao nhất khỏi q (NULL nếu rỗng) */
+TCB_t *os_waitq_pop(OsWaitQ_t *q);
+
+/* Đưa task đang chạy vào trạng thái WAITING và nhường CPU.
+ *  - q      : danh sách chờ (NULL = chỉ chờ event)
+ *  - data   : bộ đệm gắn với lần chờ (bên đánh thức chép thẳng vào đây)
+ *  - timeout: số tick, OS_WAIT_FOREVER = chờ mãi
+ * Gọi và trả về khi IRQ đang TẮT. Trả về TCB.wait_rc (OS_WAIT_OK/OS_WAIT_TIMEOUT). */
+uint8_t os_wait_current(OsWaitQ_t *q, void *data, TickType timeout);
+
+/* WAITING → READY (giữ nguyên ngữ cảnh), huỷ timer chờ, ghi wait_rc */
+void os_release_task(TCB_t *t, uint8_t rc);
+
+/* SetEvent không báo lỗi (IOC): task DORMANT → bỏ qua, không gọi
+ * ErrorHook – dữ liệu vẫn nằm trong kênh chờ task rút */
+void os_notify_event(TaskType id, EventMaskType mask);
+#endif
+
+/* true nếu đang ở ISR (IPSR != 0) – không được chặn */
+bool os_in_isr(void);
+
+/* Giá trị tick hệ thống hiện tại (s_tick) */
+TickType os_tick_now(void);
+
+/* Slot pending của task timer: mỗi nguồn callback 1 bit */
+#define OS_TIMER_SLOT_ALARM(aid)    (aid)
+#define OS_TIMER_SLOT_EP(sid, ep)   (OS_MAX_ALARMS + (sid) * OS_MAX_EXPIRY_POINT + (ep))
+#if (OS_CFG_SCHTBL)
+#  define OS_TIMER_SLOTS            (OS_MAX_ALARMS + OS_MAX_SchedTbl * OS_MAX_EXPIRY_POINT)
+#else
+#  define OS_TIMER_SLOTS            (OS_MAX_ALARMS)
+#endif
+
+#if (OS_CFG_TIMER_TASK)
+/* ISR tick: ghi fn vào slot, đánh dấu pending, báo task timer (không chặn) */
+void os_timer_defer(uint8_t slot, void (*fn)(void));
+/* Thân task timer (TASK_TIMER) */
+void os_timer_task(void *arg);
+#endif
+
+#if (OS_CFG_PT)
+/* Thân task coroutine (TASK_PT) */
+void os_pt_task(void *arg);
+#endif
+
+#if (OS_CFG_TIMING_PROT)
+/* PendSV (ASM, tham chiếu weak): from rời CPU, to vào CPU – cộng dồn
+ * thời gian thực thi và đặt lại compare ngân sách */
+void os_tp_switch(TCB_t *from, TCB_t *to);
+#endif
+
+#endif /* OS_INTERNAL_H */
@@ -0,0 +1,67 @@
+#ifndef OS_IOC_H
+#define OS_IOC_H
+
+/*
+ * =====================================================================
+ *  IOC – kênh truyền dữ liệu SPSC (1 producer / 1 consumer)
+ *  - Cấu hình tĩnh (os_ioc.c): kích thước phần tử cố định, độ sâu,
+ *    loại kênh, task/event được báo khi có dữ liệu.
+ *  - Wait-free cả 2 đầu, KHÔNG __disable_irq:
+ *      + IOC_QUEUED      : ring buffer, head do consumer ghi, tail do
+ *                          producer ghi (chỉ cập nhật chỉ số nguyên tử).
+ *      + IOC_LAST_IS_BEST: triple buffer, đổi slot bằng 1 lệnh xchg
+ *                          (LDREX/STREX) → người đọc luôn có bản mới nhất.
+ *  - Producer/consumer có thể là ISR hoặc Task (ISR→Task, Task→Task).
+ * =====================================================================
+ */
+
+#include <stdint.h>
+#include "os_kernel.h"
+
+/* Mã trả về (theo AUTOSAR IOC) */
+#define IOC_E_OK            0u
+#define IOC_E_LOST_DATA     64u     /* IocSend: kênh đầy, phần tử bị bỏ */
+#define IOC_E_LIMIT         130u    /* id không hợp lệ / sai loại kênh   */
+#define IOC_E_NO_DATA       131u    /* IocReceive/IocRead: chưa có dữ liệu */
+
+#define OS_IOC_NO_NOTIFY    0xFFu   /* notify_task: không báo task nào */
+
+typedef enum {
+    IOC_QUEUED,
+    IOC_LAST_IS_BEST
+} OsIocKind;
+
+/* Cấu hình tĩnh của 1 kênh */
+typedef struct {
+    OsIocKind      kind;
+    uint8_t        elem_size;    /* byte / phần tử */
+    uint8_t        depth;        /* QUEUED: lũy thừa của 2; LAST_IS_BEST: 3 */
+    uint8_t       *buf;          /* depth * elem_size byte */
+    TaskType       notify_task;  /* OS_IOC_NO_NOTIFY nếu không báo */
+    EventMaskType  notify_mask;  /* set event khi có dữ liệu; task DORMANT: bỏ qua,
+                                  * task tự rút kênh khi được kích hoạt lại */
+} OsIocCfg_t;
+
+/* Trạng thái runtime của 1 kênh */
+typedef struct {
+    volatile uint32_t head;      /* QUEUED: chỉ consumer ghi          */
+    volatile uint32_t tail;      /* QUEUED: chỉ producer ghi          */
+    volatile uint32_t lost;      /* số phần tử bị bỏ vì đầy            */
+    volatile uint32_t mid;       /* LAST_IS_BEST: slot giữa | IOC_FRESH */
+    uint8_t           back;      /* LAST_IS_BEST: slot của producer   */
+    uint8_t           front;     /* LAST_IS_BEST: slot của consumer   */
+    uint8_t           has_data;  /* LAST_IS_BEST: consumer đã có bản nào chưa */
+} OsIocRt_t;
+
+/* Queued */
+uint8_t IocSend(uint8_t ioc_id, const void *data);
+uint8_t IocReceive(uint8_t ioc_id, void *data);
+
+/* Last-is-best */
+uint8_t IocWrite(uint8_t ioc_id, const void *data);
+uint8_t IocRead(uint8_t ioc_id, void *data);
+
+/* Số phần tử bị bỏ (kênh QUEUED đầy) */
+uint32_t IocGetLost(uint8_t ioc_id);
+
+#endif /* OS_IOC_H */
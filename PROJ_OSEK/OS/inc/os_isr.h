@@ -0,0 +1,57 @@
+#ifndef OS_ISR_H
+#define OS_ISR_H
+
+/*
+ * =====================================================================
+ *  Khai báo ISR theo loại (OSEK)
+ *  - ISR1(name): KHÔNG gọi dịch vụ OS – handler thuần, chi phí 0.
+ *  - ISR2(name, isr_id): được gọi ActivateTask/SetEvent/IocSend/...;
+ *      wrapper tăng/giảm bộ đếm lồng ISR, mọi thay đổi READY trong ISR
+ *      chỉ cập nhật queue, schedule()+PendSV chạy 1 lần khi thoát ISR
+ *      ngoài cùng (OS_CFG_DEFERRED_DISPATCH).
+ *  - name là tên vector trong Startup/startup_stm32f103.s
+ *    (vd EXTI1_IRQHandler); isr_id thuộc enum ISR_* trong os_types.h.
+ *  - ISR2 KHÔNG được là NMI/HardFault (kernel khoá bằng PRIMASK).
+ *
+ *  Ví dụ:
+ *      ISR2(EXTI1_IRQHandler, ISR_BUTTON)
+ *      {
+ *          EXTI_ClearITPendingBit(EXTI_Line1);
+ *          SetEvent(TASK_B, EVENT_BUTTON_PRESSED);
+ *      }
+ * =====================================================================
+ */
+
+#include <stdint.h>
+#include "os_kernel.h"
+#include "os_perf.h"
+
+/* Ngữ cảnh ISR lồng nhau – biến cục bộ trên stack của wrapper */
+typedef struct {
+    uint8_t  prev_isr;
+    uint32_t prev_stamp;
+} OsIsrFrame_t;
+
+void os_isr_enter(OsIsrFrame_t *f, uint8_t isr_id);
+void os_isr_exit(OsIsrFrame_t *f);
+
+#define ISR1(name)  void name(void)
+
+#define ISR2(name, isr_id)                          \
+    static void name##_body(void);                  \
+    void name(void)                                 \
+    {                                               \
+        OsIsrFrame_t os_isr_f;                      \
+        os_isr_enter(&os_isr_f, (isr_id));          \
+        name##_body();                              \
+        os_isr_exit(&os_isr_f);                     \
+    }                                               \
+    static void name##_body(void)
+
+#if (OS_CFG_ISR_LATENCY)
+/* Độ trễ (chu kỳ) từ lúc vào ISR isr_id tới lúc task nó làm READY được
+ * dispatch (schedule() chọn; PendSV đổi ngữ cảnh ngay sau đó) */
+void GetIsrLatency(uint8_t isr_id, OsPerf_t *out, uint8_t reset);
+#endif
+
+#endif /* OS_ISR_H */
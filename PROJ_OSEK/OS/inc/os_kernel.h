@@ -23,6 +23,9 @@
  * ========================================================= */
 extern volatile TCB_t *g_current;
 extern volatile TCB_t *g_next;
+extern volatile TCB_t *g_discard;   /* task đã Terminate: PendSV bỏ qua SAVE */
+/* Số lần task bị đổi ra khi chưa kết thúc (hết lượt RR / Schedule()) */
+extern volatile uint32_t g_os_preempt;
 
 static inline TickType diff_wrap(TickType cur, TickType start, TickType max) {
     return (cur >= start) ? (cur - start) : (max - start + cur);
@@ -44,51 +47,132 @@ void OS_Init(void);
  */
 void OS_Start(void);
 
-/* Kích hoạt 1 task theo ID (đưa vào READY queue nếu đang DORMANT) */
-void ActivateTask(uint8_t tid);
+/* Kích hoạt 1 task theo ID (đưa vào READY queue nếu đang DORMANT).
+ *  E_OS_LIMIT nếu task chưa DORMANT (không kích chồng) */
+StatusType ActivateTask(TaskType tid);
 
 /* Task tự kết thúc (không quay lại): đánh dấu DORMANT + yêu cầu schedule.
  *  Nếu không còn task READY khác → ngủ WFI.
  */
-void TerminateTask(void);
+StatusType TerminateTask(void);
+/* Điểm lập lịch tường minh: có task READY được chạy trước task hiện
+ *  tại (ưu tiên cao hơn / EDF: deadline sớm hơn) → nhường CPU, chạy
+ *  tiếp sau task đó. Task giữ resource nội dùng hàm này để nhường. */
+StatusType Schedule(void);
 /*
- * Lấy trạng thái của Task
+ * Lấy ID của task đang chạy (trong PreTaskHook: task mới, PostTaskHook: task cũ)
 */
-void GetTaskState(TaskType id, uint8_t* state);
+StatusType GetTaskID(TaskRefType id);
+/*
+ * Lấy trạng thái của Task (OsTaskState_e)
+*/
+StatusType GetTaskState(TaskType id, TaskStateRefType state);
 /*
  * Kết thúc Task hiện tại và chuyển đổi sang Task tiếp theo
+ *  (E_OS_LIMIT, task hiện tại KHÔNG kết thúc, nếu id chưa DORMANT)
 */
-void ChainTask(TaskType id);
+StatusType ChainTask(TaskType id);
+#if (OS_CFG_EVENTS)
 /*
  * Chờ sự kiện của Task được set
 */
-void WaitEvent(EventMaskType mask);
+StatusType WaitEvent(EventMaskType mask);
+/*
+ * Chờ sự kiện, tối đa 'ticks' nhịp tick hệ thống.
+ *  - Kết thúc khi có event trong mask, hoặc hết giờ → kernel set
+ *    OS_EVENT_TIMEOUT vào event của task (đọc bằng GetEvent, xoá bằng ClearEvent).
+ *  - Timer chờ riêng của task được huỷ O(1) khi event tới trước.
+*/
+StatusType WaitEventTimeout(EventMaskType mask, TickType ticks);
 /*
  * Set sự kiện của Task lên 
 */
-void SetEvent(TaskType id, EventMaskType mask);
+StatusType SetEvent(TaskType id, EventMaskType mask);
+/*
+ * Set sự kiện cho cả nhóm task (1 vùng tới hạn, 1 lần lập lịch)
+*/
+StatusType SetEventGroup(uint8_t gid, EventMaskType mask);
 /*
  * Lấy sự kiện của Task
 */
-EventMaskType GetEvent(TaskType id,EventMaskType *event);
+StatusType GetEvent(TaskType id, EventMaskType *event);
 /*
  * Xoá sự kiện của TASK
 */
-void ClearEvent(EventMaskType mask);
+StatusType ClearEvent(EventMaskType mask);
+#endif /* OS_CFG_EVENTS */
 
-/* Đặt Alarm tương đối (delay_ms), có thể lặp (cycle_ms) để Activate task. */
-void SetRelAlarm(uint8_t aid, uint32_t delay_ms, uint32_t cycle_ms, uint8_t target_tid);
-void SetAbsAlarm(uint8_t aid, uint32_t delay_ms, uint32_t cycle_ms, uint8_t target_tid);
+/* Đặt Alarm tương đối (delay_ms), có thể lặp (cycle_ms); khi đến hạn chạy
+ * action cấu hình sẵn trong SetUpAlarm. E_OS_NOFUNC: alarm chưa gắn counter. */
+StatusType SetRelAlarm(uint8_t aid, uint32_t delay_ms, uint32_t cycle_ms);
+StatusType SetAbsAlarm(uint8_t aid, uint32_t delay_ms, uint32_t cycle_ms);
 void SetUpAlarm();
+/* Đọc (và reset nếu reset != 0) thống kê trễ / chu kỳ lỡ của alarm */
+StatusType GetAlarmStats(uint8_t aid, OsAlarmStats_t *out, uint8_t reset);
+#if (OS_CFG_TIMER_TASK)
+/* Số lần callback đến hạn khi lần trước chưa chạy xong (bị gộp) */
+uint32_t GetTimerOverrun(void);
+#endif
 
+#if (OS_CFG_SCHTBL)
 /*  Hàm Schedule Table*/
-void StartSchedulTblRel(uint8_t sid, TickType offset);
-void StartSchedulTblAbs(uint8_t sid, TickType start);
-void StopSchedulTbl(uint8_t sid);
-void SyncSchedulTbl(uint8_t sid, TickType new_offset);
+StatusType StartSchedulTblRel(uint8_t sid, TickType offset);
+StatusType StartSchedulTblAbs(uint8_t sid, TickType start);
+StatusType StopSchedulTbl(uint8_t sid);
+/* 'to' (đang STOP) bắt đầu đúng lúc 'from' hết chu kỳ hiện tại, 'from'
+ *  dừng. Gọi lại trước khi bàn giao → bảng kế mới thay bảng kế cũ;
+ *  to == from → huỷ bàn giao đang chờ (nguyên tử với ISR tick).
+ *  E_OS_NOFUNC: 'from' không chạy (đã bàn giao / đã dừng). */
+StatusType NextSchedulTbl(uint8_t from, uint8_t to);
+/* Đồng bộ bảng với nguồn thời gian ngoài: value = vị trí hiện tại trong
+ *  chu kỳ theo nguồn đó (0..duration-1). Bảng đang chạy: độ lệch được bù
+ *  dần ở các expiry point (max_advance/max_retard); bảng chưa chạy: bắt
+ *  đầu ngay tại vị trí value. */
+StatusType SyncSchedulTbl(uint8_t sid, TickType value);
+StatusType GetSchedulTblStatus(uint8_t sid, ScheduleTableStatusRefType status);
 void Schedul_Tick(CounterType cid);
 void Setup_SchTbl(void);
+#endif /* OS_CFG_SCHTBL */
+/* Hook lỗi (weak – ứng dụng định nghĩa lại): gọi khi API trả khác E_OK,
+ * trong ngữ cảnh của bên gọi API (task hoặc ISR). Không gọi lồng. */
+void ErrorHook(StatusType error);
+#if (OS_CFG_ERROR_HOOK)
+/* Chỉ hợp lệ trong ErrorHook: dịch vụ gây lỗi và tham số đầu tiên của nó */
+OSServiceIdType OSErrorGetServiceId(void);
+uint32_t OSErrorGetParam1(void);
+#endif
+
+/* Dừng hệ thống: tắt IRQ, gọi ShutdownHook(error), không trả về */
+void ShutdownOS(StatusType error);
+
+/* Hook OSEK do ứng dụng định nghĩa (chỉ khi OS_CFG_HOOKS = 1).
+ *  - Kernel tham chiếu WEAK: không định nghĩa → không gọi, không tốn mã.
+ *  - Pre/PostTaskHook chạy trong PendSV với IRQ tắt: ngắn, không gọi API chặn. */
+void StartupHook(void);                 /* sau OS_Init, trước task đầu tiên */
+void ShutdownHook(StatusType error);    /* trong ShutdownOS() */
+void PreTaskHook(void);                 /* task mới vừa thành g_current */
+void PostTaskHook(void);                /* task cũ sắp rời CPU */
+
+#if (OS_CFG_TIMING_PROT)
+/* Lỗi bảo vệ thời gian (weak – mặc định trả OS_CFG_TP_REACTION).
+ *  E_OS_PROTECTION_TIME: gọi trong ISR TIM2 khi task đang chạy hết ngân sách
+ *  E_OS_PROTECTION_ARRIVAL: gọi trong ActivateTask/ChainTask bị từ chối */
+ProtectionReturnType ProtectionHook(StatusType fatal);
+/* Đọc (và reset nếu reset != 0) thống kê ngân sách của task */
+StatusType GetTaskTiming(TaskType id, OsTaskTimingStats_t *out, uint8_t reset);
+#endif
+
+#if (OS_CFG_DEADLINE_MON)
+/* Số lần task kết thúc sau deadline của lần kích hoạt đó */
+StatusType GetDeadlineMisses(TaskType id, uint32_t *misses, uint8_t reset);
+#endif
+
 /* Hàm Tick do PORT gọi mỗi nhịp SysTick (được gọi từ SysTick_Handler trong os_port.c) */
 void os_on_tick(void);
+/* Bù n tick một lần (sau tickless idle / khi tick bị dồn): alarm đến hạn
+ * trong khoảng đó được xử lý theo chính sách catch-up của từng alarm.
+ * Chỉ gọi trong ISR (vd. ngắt đánh thức), KHÔNG giữ IRQ tắt khi gọi:
+ * kernel mở lại IRQ giữa chừng */
+void os_on_ticks(TickType n);
 
 #endif /* OS_KERNEL_H */
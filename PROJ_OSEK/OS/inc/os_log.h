@@ -0,0 +1,62 @@
+#ifndef OS_LOG_H
+#define OS_LOG_H
+
+/*
+ * =====================================================================
+ *  Deferred binary log
+ *  - Call-site chỉ ghi: ID chuỗi định dạng (16 bit) + tham số thô (word)
+ *    vào ring buffer RAM, không format trên MCU.
+ *  - Chuỗi định dạng nằm trong section ".os_logstr" (INFO) của ELF:
+ *    KHÔNG nạp vào Flash; ID = địa chỉ của chuỗi trong section đó.
+ *  - Ghi lock-free (LDREX/STREX), gọi được từ Task lẫn ISR.
+ *  - Task ưu tiên thấp (Idle) gọi OS_LogDrain() để đẩy byte ra UART;
+ *    host dùng scripts/os_log_decode.py + Tools/os_test.elf để giải mã.
+ *
+ *  Khung 1 bản ghi (word, little-endian khi ra dây):
+ *      [hdr] [arg0] ... [argN-1]
+ *      hdr = (id << 16) | (nargs << 8) | OS_LOG_COMMIT
+ * =====================================================================
+ */
+
+#include <stdint.h>
+
+#ifndef OS_CFG_LOG
+#  define OS_CFG_LOG            1u
+#endif
+
+#ifndef OS_LOG_BUF_WORDS
+#  define OS_LOG_BUF_WORDS      256u    /* 1 KB RAM, phải là lũy thừa của 2 */
+#endif
+
+#define OS_LOG_MAX_ARGS         8u
+#define OS_LOG_COMMIT           0xA5u   /* byte thấp của hdr: bản ghi đã ghi xong */
+
+#define OS_LOG_HDR(id, n)       (((uint32_t)(id) << 16) | ((uint32_t)(n) << 8) | OS_LOG_COMMIT)
+
+#if OS_CFG_LOG
+/* OS_LOG("fmt %u %x", a, b): tham số được ép về uint32_t (không hỗ trợ float/%s) */
+#define OS_LOG(fmt, ...)                                                          \
+    do {                                                                          \
+        static const char os_log_fmt_[]                                           \
+            __attribute__((section(".os_logstr"), used)) = fmt;                   \
+        const uint32_t os_log_arg_[] = { 0u, ##__VA_ARGS__ };                     \
+        _Static_assert(sizeof(os_log_arg_) / sizeof(uint32_t) - 1u                \
+                       <= OS_LOG_MAX_ARGS, "OS_LOG: too many arguments");         \
+        os_log_write((uint16_t)(uintptr_t)os_log_fmt_, &os_log_arg_[1],           \
+                     (uint8_t)(sizeof(os_log_arg_) / sizeof(uint32_t) - 1u));     \
+    } while (0)
+#else
+#define OS_LOG(fmt, ...)        do { } while (0)
+#endif
+
+/* Ghi 1 bản ghi (gọi qua macro OS_LOG) */
+void os_log_write(uint16_t id, const uint32_t *args, uint8_t nargs);
+
+/* Đẩy tối đa max_records bản ghi đã commit ra 'put' (từng byte).
+ * Chỉ 1 consumer (thường là Task_Idle). Trả về số bản ghi đã đẩy. */
+uint32_t OS_LogDrain(void (*put)(uint8_t b), uint32_t max_records);
+
+/* Số bản ghi bị bỏ do buffer đầy */
+uint32_t OS_LogGetDropped(void);
+
+#endif /* OS_LOG_H */
@@ -0,0 +1,46 @@
+#ifndef OS_MSGQ_H
+#define OS_MSGQ_H
+
+/*
+ * =====================================================================
+ *  Message queue có chặn (kernel)
+ *  - Phần tử kích thước cố định, cấu hình tĩnh trong os_msgq.c.
+ *  - MsgQReceive chặn khi rỗng, MsgQSend chặn khi đầy; timeout (tick)
+ *    chạy trên timer chờ của task (cơ chế Alarm/Counter của kernel).
+ *  - Hand-off trực tiếp: nếu đã có task chờ nhận, dữ liệu được chép
+ *    thẳng vào bộ đệm của task đó (chép 1 lần, không qua ring).
+ *    Tương tự, khi lấy 1 phần tử khỏi queue đầy, thông điệp của task
+ *    gửi đang chờ được chép thẳng vào ring.
+ *  - Danh sách chờ (gửi/nhận) sắp theo ưu tiên task.
+ *  - Trong ISR: chỉ dùng với timeout = 0 (không chặn).
+ * =====================================================================
+ */
+
+#include <stdint.h>
+#include "os_kernel.h"
+
+/* Mã trả về */
+#define MSGQ_E_OK           0u
+#define MSGQ_E_TIMEOUT      1u      /* hết thời gian chờ */
+#define MSGQ_E_EMPTY        2u      /* timeout = 0 và queue rỗng */
+#define MSGQ_E_FULL         3u      /* timeout = 0 và queue đầy  */
+#define MSGQ_E_ID           4u      /* qid không hợp lệ */
+
+typedef struct {
+    uint8_t   msg_size;     /* byte / thông điệp */
+    uint8_t   depth;        /* số thông điệp tối đa (>= 1) */
+    uint8_t  *buf;          /* depth * msg_size byte */
+} OsMsgQCfg_t;
+
+typedef struct {
+    uint8_t    head;        /* vị trí đọc */
+    uint8_t    count;       /* số thông điệp đang có */
+    OsWaitQ_t  rx_wait;     /* task chờ nhận (queue rỗng) */
+    OsWaitQ_t  tx_wait;     /* task chờ gửi  (queue đầy)  */
+} OsMsgQRt_t;
+
+/* timeout: 0 = không chờ, OS_WAIT_FOREVER = chờ mãi, khác = số tick */
+uint8_t MsgQSend(uint8_t qid, const void *msg, TickType timeout);
+uint8_t MsgQReceive(uint8_t qid, void *msg, TickType timeout);
+
+#endif /* OS_MSGQ_H */
@@ -0,0 +1,61 @@
+#ifndef OS_PERF_H
+#define OS_PERF_H
+
+/*
+ * ============================================================
+ *  Đo đạc chu kỳ (DWT->CYCCNT)
+ *  - OsPerf_t: thống kê last/min/max/count/total theo chu kỳ CPU.
+ *  - Dùng trong benchmark (app/App_Bench.c) và các probe của kernel;
+ *    đọc kết quả qua debugger hoặc OS_LOG.
+ * ============================================================
+ */
+
+#include <stdint.h>
+#include "stm32f10x.h"
+
+typedef struct {
+    uint32_t last;
+    uint32_t min;
+    uint32_t max;
+    uint32_t count;
+    uint32_t total;     /* tổng chu kỳ (có thể tràn nếu đo quá lâu) */
+} OsPerf_t;
+
+static inline uint32_t os_perf_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+static inline void os_perf_reset(OsPerf_t *p)
+{
+    p->last = 0u;
+    p->min = 0xFFFFFFFFu;
+    p->max = 0u;
+    p->count = 0u;
+    p->total = 0u;
+}
+
+static inline void os_perf_add(OsPerf_t *p, uint32_t cycles)
+{
+    p->last = cycles;
+    if (cycles < p->min) p->min = cycles;
+    if (cycles > p->max) p->max = cycles;
+    p->count++;
+    p->total += cycles;
+}
+
+static inline uint32_t os_perf_avg(const OsPerf_t *p)
+{
+    return (p->count != 0u) ? (p->total / p->count) : 0u;
+}
+
+#ifdef APP_BENCH
+/* Probe kernel: thời gian 1 lần os_on_tick() (ISR SysTick) */
+extern OsPerf_t g_os_tick_perf;
+/* Mốc DWT->CYCCNT lúc vào os_on_tick() gần nhất */
+extern volatile uint32_t g_os_tick_t0;
+/* Probe kernel: 1 lần schedule() (lấy task khỏi READY + đặt vé) */
+extern OsPerf_t g_os_sched_perf;
+#endif
+
+#endif /* OS_PERF_H */
@@ -0,0 +1,50 @@
+#ifndef OS_POOL_H
+#define OS_POOL_H
+
+/*
+ * =====================================================================
+ *  Pool khối cố định (không dùng malloc của newlib)
+ *  - Các lớp kích thước cấu hình tĩnh trong os_pool.c (POOL_16/32/64...).
+ *  - PoolAlloc/PoolFree: O(1), lock-free (danh sách rỗi kiểu stack,
+ *    đổi đỉnh bằng LDREX/STREX) → gọi được từ ISR lẫn Task.
+ *  - Trao quyền sở hữu bằng con trỏ (qua IOC/queue/event) → zero-copy:
+ *    producer cấp khối, điền dữ liệu, gửi con trỏ; consumer dùng xong
+ *    thì PoolFree().
+ *  - Thống kê: đang dùng, high-water, số lần cấp thất bại.
+ * =====================================================================
+ */
+
+#include <stdint.h>
+#include "os_kernel.h"
+
+typedef struct {
+    uint16_t block_size;    /* byte / khối (bội số của 4) */
+    uint16_t num_blocks;
+    uint32_t *storage;      /* num_blocks * block_size byte */
+} OsPoolCfg_t;
+
+typedef struct {
+    uint32_t used;          /* số khối đang cấp phát */
+    uint32_t high_water;    /* đỉnh 'used' từ lúc khởi động */
+    uint32_t fails;         /* số lần PoolAlloc trả NULL */
+} OsPoolStats_t;
+
+/* Dựng danh sách rỗi (gọi trong OS_Init) */
+void os_pool_init(void);
+
+/* Cấp 1 khối từ pool 'pid' (NULL nếu hết → gọi PoolExhaustedHook) */
+void *PoolAlloc(uint8_t pid);
+
+/* Cấp từ lớp nhỏ nhất có block_size >= size */
+void *PoolAllocSize(uint32_t size);
+
+/* Trả khối về đúng pool của nó (tra theo địa chỉ) */
+void PoolFree(void *blk);
+
+/* Lấy thống kê của pool */
+void PoolGetStats(uint8_t pid, OsPoolStats_t *out);
+
+/* Hook khi pool cạn (weak – ứng dụng có thể định nghĩa lại; gọi cả trong ISR) */
+void PoolExhaustedHook(uint8_t pid);
+
+#endif /* OS_POOL_H */
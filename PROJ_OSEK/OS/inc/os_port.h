@@ -50,6 +50,16 @@ void os_port_init(void);
 /* (Tùy chọn) Cấu hình lại SysTick theo tần số tùy ý (Hz) */
 void os_port_start_systick(uint32_t tick_hz);
 
+/* Bật bộ đếm chu kỳ DWT->CYCCNT (dùng cho đo đạc/benchmark, xem os_perf.h) */
+void os_port_cycle_init(void);
+
+/* Timer cưỡng chế ngân sách (TIM2, 1 MHz, 16 bit, ưu tiên NVIC cao nhất):
+ *  - arm(us): ngắt compare sau 'us' µs (tối đa 65535; kernel tự nạp tiếp)
+ *  - disarm(): tắt ngắt compare và xoá cờ */
+void os_port_tp_init(void);
+void os_port_tp_arm(uint32_t us);
+void os_port_tp_disarm(void);
+
 /* Yêu cầu PendSV xảy ra (đổi ngữ cảnh ở cuối ISR hiện tại) */
 void os_trigger_pendsv(void);
 
@@ -64,6 +74,49 @@ uint32_t *os_task_stack_init(void (*entry)(void *),
                              void *arg,
                              uint32_t *top);
 
+/* Vị trí word trong khung ban đầu (tính từ &R4) */
+#define OS_FRAME_R0     8u
+#define OS_FRAME_LR     13u
+#define OS_FRAME_PC     14u
+#define OS_FRAME_XPSR   15u
+
+/* Kích hoạt lại task từ khung đã dựng sẵn lúc OS_Init (frame = &R4 do
+ * os_task_stack_init trả về). entry() không đọc R1-R3, R12, R4-R11 nên
+ * chỉ ghi lại 4 word mà lần chạy trước có thể đã ghi đè. */
+static inline uint32_t *os_task_frame_rearm(uint32_t *frame,
+                                            void (*entry)(void *),
+                                            void *arg)
+{
+    frame[OS_FRAME_R0]   = (uint32_t)arg;
+    frame[OS_FRAME_LR]   = ((uint32_t)os_task_exit) | 1u;
+    frame[OS_FRAME_PC]   = ((uint32_t)entry) | 1u;
+    frame[OS_FRAME_XPSR] = 0x01000000u;     /* T-bit */
+    return frame;
+}
+
+/* Chạy lại task hiện tại từ đầu entry NGAY tại Thread mode (không qua
+ * PendSV): PSP về đỉnh stack của khung ban đầu (frame + 16 word), R0 = arg,
+ * LR = os_task_exit, mở IRQ rồi nhảy vào entry. Gọi khi IRQ đang TẮT.
+ * Dùng cho ChainTask(chính nó): khung của task KHÔNG thể dựng lại khi
+ * task còn đang chạy trên chính stack đó (PendSV sẽ đè lên khi stacking). */
+static inline OS_NORETURN void os_task_restart(uint32_t *frame,
+                                               void (*entry)(void *),
+                                               void *arg)
+{
+    __asm volatile (
+        "msr  psp, %0   \n"
+        "isb            \n"
+        "mov  r0, %1    \n"
+        "mov  lr, %2    \n"
+        "cpsie i        \n"
+        "bx   %3        \n"
+        :
+        : "r" (frame + 16), "r" (arg),
+          "r" (((uint32_t)os_task_exit) | 1u), "r" (((uint32_t)entry) | 1u)
+        : "r0", "lr", "memory");
+    __builtin_unreachable();
+}
+
 #ifdef __cplusplus
 }
 #endif
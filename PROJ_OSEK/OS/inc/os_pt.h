@@ -0,0 +1,76 @@
+#ifndef OS_PT_H
+#define OS_PT_H
+
+/*
+ * =====================================================================
+ *  Coroutine không stack (protothread, kiểu Duff's device)
+ *  - Thân coroutine: uint8_t fn(OsPt_t *pt), bọc bằng PT_BEGIN/PT_END.
+ *    Điểm chờ = 'return' + nhãn case __LINE__ → lần chạy kế nhảy thẳng
+ *    vào sau điểm chờ. Trạng thái chỉ là OsPt_t (12 byte).
+ *  - Mọi coroutine chạy lần lượt trên stack chung của TASK_PT; được
+ *    chạy lại khi có PtSetEvent() (task/ISR) hoặc PT_DELAY hết hạn.
+ *  - Hạn chế:
+ *      + biến cục bộ KHÔNG giữ được qua điểm chờ → dùng static/OsPt_t
+ *      + không 'switch' của ứng dụng bao quanh điểm chờ
+ *      + mỗi dòng tối đa 1 điểm chờ (nhãn dùng __LINE__)
+ *      + không gọi API chặn (WaitEvent, MsgQ...) trong coroutine
+ *  - RAM: 12 byte / coroutine + 1 stack STACK_WORDS_PT (384 byte) chung
+ *    → 24 coroutine (288 byte) < 1 stack task (96 word = 384 byte).
+ * =====================================================================
+ */
+
+#include <stdint.h>
+#include "os_kernel.h"
+
+/* Giá trị trả về của thân coroutine */
+#define PT_WAITING      0u      /* đang chờ event / điều kiện / thời gian */
+#define PT_YIELDED      1u      /* nhường: chạy lại ngay ở vòng kế của TASK_PT */
+#define PT_ENDED        2u      /* tới PT_END: event kế tiếp chạy lại từ đầu */
+
+typedef struct {
+    uint16_t               lc;      /* điểm tiếp tục (__LINE__), 0 = đầu */
+    uint8_t                timed;   /* 1 = đang PT_DELAY tới 'wake' */
+    volatile EventMaskType ev;      /* event đã nhận, chưa xoá */
+    TickType               wake;    /* mốc s_tick hết PT_DELAY */
+} OsPt_t;
+
+typedef uint8_t (*OsPtFn)(OsPt_t *pt);
+
+#define PT_BEGIN(pt)            switch ((pt)->lc) { case 0u:
+
+#define PT_END(pt)              } (pt)->lc = 0u; return PT_ENDED
+
+/* Chờ tới khi cond đúng (chỉ xét lại khi coroutine được đánh thức) */
+#define PT_WAIT_UNTIL(pt, cond)                                             \
+    do {                                                                    \
+        (pt)->lc = (uint16_t)__LINE__; case __LINE__:                       \
+        if (!(cond)) return PT_WAITING;                                     \
+    } while (0)
+
+/* Chờ 1 trong các event của mask (xoá bằng PtClearEvent) */
+#define PT_WAIT_EVENT(pt, mask) PT_WAIT_UNTIL(pt, ((pt)->ev & (mask)) != 0u)
+
+/* Nhường TASK_PT cho coroutine khác, chạy tiếp ở vòng kế */
+#define PT_YIELD(pt)                                                        \
+    do {                                                                    \
+        (pt)->lc = (uint16_t)__LINE__; return PT_YIELDED; case __LINE__:;   \
+    } while (0)
+
+/* Chờ 'ticks' tick hệ thống */
+#define PT_DELAY(pt, ticks)                                                 \
+    do {                                                                    \
+        os_pt_arm((pt), (ticks));                                           \
+        PT_WAIT_UNTIL(pt, os_pt_expired(pt));                               \
+    } while (0)
+
+/* Báo event cho coroutine (task hoặc ISR, không chặn). E_OS_ID nếu id sai */
+StatusType PtSetEvent(uint8_t pt_id, EventMaskType mask);
+
+/* Xoá event đã xử lý (trong thân coroutine) */
+void PtClearEvent(OsPt_t *pt, EventMaskType mask);
+
+/* Dùng bởi PT_DELAY */
+void os_pt_arm(OsPt_t *pt, TickType ticks);
+bool os_pt_expired(OsPt_t *pt);
+
+#endif /* OS_PT_H */
@@ -0,0 +1,51 @@
+#ifndef OS_SIGNAL_H
+#define OS_SIGNAL_H
+
+/*
+ * =====================================================================
+ *  Signal buffer – chia sẻ dữ liệu 1 writer / nhiều reader (seqlock)
+ *  - Writer ghi không chặn: seq lẻ = đang ghi, seq chẵn = ổn định.
+ *  - Reader đọc bản sao rồi kiểm tra seq; chỉ đọc lại khi bị "rách"
+ *    (writer chen vào giữa). Không __disable_irq ở cả 2 phía.
+ *  - Dữ liệu kích thước bất kỳ (struct lớn hơn 1 word).
+ *
+ *  Hai biến thể:
+ *   - OS_SIGNAL_DEFINE    : 1 bản sao. Reader KHÔNG được có ưu tiên cao
+ *                           hơn writer (ví dụ reader trong ISR đọc dữ liệu
+ *                           do task ghi) → dùng SignalTryRead() hoặc DB.
+ *   - OS_SIGNAL_DEFINE_DB : 2 bản sao (latch). Luôn có 1 bản ổn định để
+ *                           đọc → reader không bao giờ phải chờ writer;
+ *                           dùng khi ISR publish snapshot hoặc reader là ISR.
+ *  - Chỉ 1 writer cho mỗi signal.
+ * =====================================================================
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    volatile uint32_t seq;      /* số thứ tự ghi */
+    uint16_t          size;     /* byte / bản sao */
+    uint8_t           dbuf;     /* 1 = 2 bản sao (latch) */
+    void             *buf;      /* dbuf ? 2 * size : size byte */
+} OsSignal_t;
+
+/* Khai báo 1 signal kiểu 'type' */
+#define OS_SIGNAL_DEFINE(name, type)                                        \
+    static type name##_buf_[1];                                             \
+    OsSignal_t name = { .seq = 0u, .size = sizeof(type), .dbuf = 0u, .buf = name##_buf_ }
+
+#define OS_SIGNAL_DEFINE_DB(name, type)                                     \
+    static type name##_buf_[2];                                             \
+    OsSignal_t name = { .seq = 0u, .size = sizeof(type), .dbuf = 1u, .buf = name##_buf_ }
+
+/* Writer: publish giá trị mới (không chặn) */
+void SignalWrite(OsSignal_t *s, const void *src);
+
+/* Reader: đọc 1 snapshot nhất quán (tự đọc lại nếu bị rách) */
+void SignalRead(const OsSignal_t *s, void *dst);
+
+/* Reader 1 lần: false nếu writer đang ghi/vừa ghi chen vào (không lặp) */
+bool SignalTryRead(const OsSignal_t *s, void *dst);
+
+#endif /* OS_SIGNAL_H */
@@ -5,21 +5,246 @@
 /* =========================================================
  *  Cấu hình tổng quát (có thể điều chỉnh theo ứng dụng)
  * ========================================================= */
+/* Lớp tuân thủ OSEK (conformance class) – tập tính năng lúc build:
+ *  - OS_CC_BCC1: chỉ task cơ bản. Bỏ event và mọi dịch vụ chờ (WaitEvent,
+ *    SetEvent, timer chờ của task, message queue, task timer, coroutine)
+ *    → ActivateTask/ISR tick không còn nhánh WAITING.
+ *  - OS_CC_ECC1: thêm task mở rộng (event, chờ có timeout) – mặc định.
+ *  - BCC2/ECC2 (kích hoạt chồng) không hỗ trợ: ActivateTask khi task
+ *    chưa DORMANT luôn trả E_OS_LIMIT. */
+#define OS_CC_BCC1              1u
+#define OS_CC_BCC2              2u
+#define OS_CC_ECC1              3u
+#define OS_CC_ECC2              4u
+#ifndef OS_CFG_CC
+#  define OS_CFG_CC             OS_CC_ECC1
+#endif
+#if ((OS_CFG_CC) == OS_CC_BCC2) || ((OS_CFG_CC) == OS_CC_ECC2)
+#  error "multiple activation (BCC2/ECC2) is not supported"
+#endif
+#define OS_CFG_EVENTS           ((OS_CFG_CC) == OS_CC_ECC1)
+
+/* 1: schedule table (Start/Stop/Next/SyncSchedulTbl); 0: bỏ cả API lẫn
+ *    lần quét bảng trong ISR tick */
+#ifndef OS_CFG_SCHTBL
+#  define OS_CFG_SCHTBL         1u
+#endif
+
+/* Hành động alarm / expiry point ngoài ActivateTask. Tắt loại không dùng
+ * → handler của nó không được biên dịch (cấu hình còn dùng loại đó báo
+ * lỗi lúc build). */
+#ifndef OS_CFG_ALARM_SETEVENT
+#  define OS_CFG_ALARM_SETEVENT (OS_CFG_EVENTS)
+#endif
+#ifndef OS_CFG_ALARM_CALLBACK
+#  define OS_CFG_ALARM_CALLBACK 1u
+#endif
+#if (OS_CFG_ALARM_SETEVENT) && !(OS_CFG_EVENTS)
+#  error "OS_CFG_ALARM_SETEVENT requires events (OS_CC_ECC1)"
+#endif
+
+/* 1: callback của Alarm/Schedule Table chạy trong task timer của kernel
+ *    (ISR tick chỉ đánh dấu pending); 0: gọi thẳng trong ISR tick */
+#ifndef OS_CFG_TIMER_TASK
+#  define OS_CFG_TIMER_TASK     ((OS_CFG_EVENTS) && (OS_CFG_ALARM_CALLBACK))
+#endif
+
+/* 1: coroutine không stack (os_pt.h) – chạy lần lượt trên stack chung
+ *    của TASK_PT, được đánh thức bằng PtSetEvent() / PT_DELAY */
+#ifndef OS_CFG_PT
+#  define OS_CFG_PT             (OS_CFG_EVENTS)
+#endif
+#if ((OS_CFG_TIMER_TASK) || (OS_CFG_PT)) && !(OS_CFG_EVENTS)
+#  error "OS_CFG_TIMER_TASK / OS_CFG_PT wait on events (OS_CC_ECC1)"
+#endif
+#if defined(APP_BENCH) && !((OS_CFG_ALARM_SETEVENT) && (OS_CFG_ALARM_CALLBACK))
+#  error "APP_BENCH uses every alarm action (OS_CC_ECC1, all actions enabled)"
+#endif
+
+/* 1: trong ISR loại 2 (os_isr_enter/os_isr_exit) chỉ cập nhật READY
+ *    queue, schedule()+PendSV chạy 1 lần khi thoát ISR ngoài cùng */
+#ifndef OS_CFG_DEFERRED_DISPATCH
+#  define OS_CFG_DEFERRED_DISPATCH  1u
+#endif
+
+/* 1: đo độ trễ ISR loại 2 → dispatch task (DWT->CYCCNT, GetIsrLatency) */
+#ifndef OS_CFG_ISR_LATENCY
+#  ifdef APP_BENCH
+#    define OS_CFG_ISR_LATENCY  1u
+#  else
+#    define OS_CFG_ISR_LATENCY  0u
+#  endif
+#endif
+
+/* 1: EXTENDED status – mọi API kiểm tra id/tham số/ngữ cảnh gọi
+ *    (E_OS_ID, E_OS_VALUE, E_OS_CALLEVEL, ...): build thử nghiệm
+ * 0: STANDARD status – các kiểm tra trên bị bỏ khỏi mã, chỉ còn lỗi
+ *    OSEK bắt buộc (E_OS_LIMIT, E_OS_NOFUNC, ...): build phát hành */
+#ifndef OS_STATUS_EXTENDED
+#  define OS_STATUS_EXTENDED    1u
+#endif
+
+/* 1: gọi ErrorHook() + ghi service id khi API trả lỗi; 0: không tốn gì */
+#ifndef OS_CFG_ERROR_HOOK
+#  define OS_CFG_ERROR_HOOK     1u
+#endif
+
+/* 1: gọi StartupHook/ShutdownHook và Pre/PostTaskHook ở các điểm đổi
+ *    task trong C (ứng dụng định nghĩa hook). PendSV/SVC (ASM) luôn gọi
+ *    Pre/PostTaskHook nếu symbol tồn tại (tham chiếu weak). */
+#ifndef OS_CFG_HOOKS
+#  define OS_CFG_HOOKS          0u
+#endif
+
+/* 1: bảo vệ thời gian – ngân sách thực thi / khoảng cách kích hoạt tối
+ *    thiểu cho từng task (bảng tp_cfg trong os_kernel.c). Đo bằng
+ *    DWT->CYCCNT, cưỡng chế bằng compare của TIM2 (ưu tiên NVIC cao nhất).
+ *    Build benchmark tắt để không nhiễu phép đo đổi ngữ cảnh. */
+#ifndef OS_CFG_TIMING_PROT
+#  ifdef APP_BENCH
+#    define OS_CFG_TIMING_PROT  0u
+#  else
+#    define OS_CFG_TIMING_PROT  1u
+#  endif
+#endif
+/* Phản ứng mặc định khi vượt ngân sách (ProtectionHook weak của kernel trả về) */
+#ifndef OS_CFG_TP_REACTION
+#  define OS_CFG_TP_REACTION    PRO_TERMINATETASKISR
+#endif
+
+/* 1: mỗi lần kích hoạt có deadline tuyệt đối (tick), đếm deadline bị lỡ
+ *    khi task kết thúc (GetDeadlineMisses) */
+#ifndef OS_CFG_DEADLINE_MON
+#  define OS_CFG_DEADLINE_MON   1u
+#endif
+/* 1: READY là min-heap theo deadline (EDF không preempt) thay cho FIFO;
+ *    0: FIFO + chen đầu cho ưu tiên ≥ OS_PRIO_URGENT */
+#ifndef OS_CFG_EDF
+#  define OS_CFG_EDF            0u
+#endif
+#if (OS_CFG_EDF) && !(OS_CFG_DEADLINE_MON)
+#  error "OS_CFG_EDF requires OS_CFG_DEADLINE_MON"
+#endif
+/* 1: cắt lượt (round-robin) giữa các task CÙNG ưu tiên – số tick mỗi
+ *    lượt theo mức ưu tiên (bảng g_rr_slice trong os_kernel.c, 0 = không
+ *    cắt). Chỉ cho READY FIFO: mặc định tắt khi EDF và trong build
+ *    benchmark (đo ổn định). */
+#ifndef OS_CFG_RR
+#  if defined(APP_BENCH) || (OS_CFG_EDF)
+#    define OS_CFG_RR           0u
+#  else
+#    define OS_CFG_RR           1u
+#  endif
+#endif
+/* Heap EDF không xếp theo mức ưu tiên → không có "cuối mức" để cắt
+ * lượt: bỏ RR thay vì hỏng build (bảng đếm rq_prio_n chỉ có ở FIFO) */
+#if (OS_CFG_RR) && (OS_CFG_EDF)
+#  undef  OS_CFG_RR
+#  define OS_CFG_RR             0u
+#endif
+/* 1: dùng bảng resource nội (ires_members trong os_kernel.c);
+ *    0: nhóm rỗng → thành viên bị cắt lượt như task khác (so sánh
+ *    g_os_preempt giữa 2 bản build) */
+#ifndef OS_CFG_IRES
+#  define OS_CFG_IRES           1u
+#endif
+
+/* Task có ưu tiên ≥ OS_PRIO_URGENT được chen ĐẦU READY queue
+ * (run-to-completion: chạy ngay ở điểm lập lịch kế tiếp) */
+#define OS_PRIO_URGENT          5u
+#ifndef OS_TIMER_TASK_PRIO
+#  define OS_TIMER_TASK_PRIO    OS_PRIO_URGENT
+#endif
+
+#ifndef OS_PT_TASK_PRIO
+#  define OS_PT_TASK_PRIO       2u   /* cùng mức task nền */
+#endif
+
+/* Task chỉ có trong build benchmark: TASK_BENCH0.. dùng chung thân
+ * Bench_Task (arg = chỉ số), vai trò theo pha đo của Bench_Run */
+#ifdef APP_BENCH
+#  define OS_BENCH_TASKS        16u
+#else
+#  define OS_BENCH_TASKS        0u
+#endif
+
 #ifndef OS_MAX_TASKS
-#  define OS_MAX_TASKS          5u   /* INIT, A, B, IDLE (ví dụ) */
+   /* INIT, A, B, C, IDLE, D [, TIMER] [, PT] [, BENCH0..] */
+#  define OS_MAX_TASKS          (6u + (OS_CFG_TIMER_TASK) + (OS_CFG_PT) + (OS_BENCH_TASKS))
 #endif
 
 #ifndef OS_MAX_ALARMS
-#  define OS_MAX_ALARMS         4u
+#  ifdef APP_BENCH
+#    define OS_MAX_ALARMS       34u  /* 0: app, 1: callback chậm, 2..33: bench expiry */
+#  else
+#    define OS_MAX_ALARMS       4u
+#  endif
 #endif
 
 #define OS_MAX_COUNTER          2u
 #define EVENT_BUTTON_PRESSED    1u 
+#define EVENT_MODE_CHANGED      2u      /* phát cho TASKGROUP_MODE khi đổi chế độ */
+/* Bit event dành riêng: WaitEventTimeout() kết thúc do hết thời gian.
+ * Ứng dụng không dùng bit này cho event của mình. */
+#define OS_EVENT_TIMEOUT        0x80000000u
 #define OS_MAX_EXPIRY_POINT     5u
-#define OS_MAX_SchedTbl         3u
+
+/* Thời gian chờ (tick) cho các dịch vụ chặn: 0 = không chờ */
+#define OS_WAIT_FOREVER         0xFFFFFFFFu
+
+/* Kết quả chờ lưu trong TCB.wait_rc */
+#define OS_WAIT_OK              0u
+#define OS_WAIT_TIMEOUT         1u
+
+/* Mã trả về của API (OSEK) */
+typedef uint8_t StatusType;
+#define E_OK                    0u
+#define E_OS_ACCESS             1u
+#define E_OS_CALLEVEL           2u
+#define E_OS_ID                 3u
+#define E_OS_LIMIT              4u
+#define E_OS_NOFUNC             5u
+#define E_OS_RESOURCE           6u
+#define E_OS_STATE              7u
+#define E_OS_VALUE              8u
+#define E_OS_PROTECTION_TIME    15u     /* vượt ngân sách thực thi */
+#define E_OS_PROTECTION_ARRIVAL 16u     /* kích hoạt sớm hơn khoảng tối thiểu */
+
+/* Kết quả ProtectionHook(): kernel xử lý lỗi bảo vệ thế nào */
+typedef enum {
+    PRO_IGNORE = 0,         /* chỉ đếm (ngân sách: task chạy tiếp, không giới hạn) */
+    PRO_TERMINATETASKISR,   /* kết thúc task vi phạm (ARRIVAL: bỏ lần kích hoạt) */
+    PRO_SHUTDOWN            /* ShutdownOS() */
+} ProtectionReturnType;
+
+/* Dịch vụ gây lỗi (OSErrorGetServiceId() trong ErrorHook) */
+typedef enum {
+    OSServiceId_ActivateTask = 0,
+    OSServiceId_TerminateTask,
+    OSServiceId_ChainTask,
+    OSServiceId_GetTaskState,
+    OSServiceId_WaitEvent,
+    OSServiceId_SetEvent,
+    OSServiceId_SetEventGroup,
+    OSServiceId_GetEvent,
+    OSServiceId_ClearEvent,
+    OSServiceId_SetRelAlarm,
+    OSServiceId_SetAbsAlarm,
+    OSServiceId_GetAlarmStats,
+    OSServiceId_StartScheduleTable,
+    OSServiceId_StopScheduleTable,
+    OSServiceId_SyncScheduleTable,
+    OSServiceId_GetScheduleTableStatus,
+    OSServiceId_NextScheduleTable,
+    OSServiceId_GetTaskTiming,
+    OSServiceId_GetDeadlineMisses,
+    OSServiceId_Schedule
+} OSServiceIdType;
 
 typedef uint32_t EventMaskType;
 typedef uint8_t TaskType;
+typedef uint8_t *TaskStateRefType;
+typedef TaskType *TaskRefType;
 typedef uint8_t CounterType;
 typedef uint32_t TickType;
 /* ID Task do ứng dụng quy ước (bạn có thể đổi theo dự án) */
@@ -28,7 +253,98 @@ enum {
     TASK_A    = 1u,
     TASK_B    = 2u, 
     TASK_C    = 3u,
-    TASK_IDLE = 4u
+    TASK_IDLE = 4u,
+    TASK_D    = 5u,         /* chẩn đoán nền: CRC flash (cùng mức B/C) */
+#if (OS_CFG_TIMER_TASK)
+    TASK_TIMER,             /* task của kernel: chạy callback hoãn từ ISR tick */
+#endif
+#if (OS_CFG_PT)
+    TASK_PT,                /* task của kernel: chạy các coroutine (os_pt.c) */
+#endif
+#ifdef APP_BENCH
+    TASK_BENCH0,            /* benchmark: OS_BENCH_TASKS task liên tiếp */
+#endif
+};
+/* ID nhóm task cho SetEventGroup() (bảng cấu hình tĩnh nằm trong os_kernel.c) */
+enum {
+    TASKGROUP_MODE = 0u,    /* các task quan tâm tới đổi chế độ xe */
+#ifdef APP_BENCH
+    TASKGROUP_BENCH8,       /* benchmark: TASK_BENCH0..7  */
+    TASKGROUP_BENCH16,      /* benchmark: TASK_BENCH0..15 */
+#endif
+    OS_MAX_TASKGROUP
+};
+/* ID resource nội (OSEK internal resource, bảng tĩnh trong os_kernel.c):
+ * task trong nhóm giữ resource suốt lúc chạy → không bị cắt lượt, chỉ
+ * đổi task ở Schedule()/WaitEvent/kết thúc. Mỗi task tối đa 1 nhóm. */
+enum {
+    IRES_IO = 0u,           /* Task_B / Task_C: log UART + nút GPIO (cùng mức 2) */
+    OS_MAX_IRES
+};
+/* ID ISR loại 2 (khai báo bằng ISR2(), OS/inc/os_isr.h) – dùng cho
+ * thống kê độ trễ từ lúc vào ISR tới lúc dispatch task mà ISR làm READY */
+enum {
+    ISR_SYSTICK = 0u,       /* os_on_tick(): alarm, schedule table, timeout */
+#if (OS_CFG_TIMING_PROT)
+    ISR_TIMING,             /* TIM2 compare: hết ngân sách thực thi */
+#endif
+#ifdef APP_BENCH
+    ISR_BENCH,              /* TIM3 one-pulse: producer IOC cho BENCH_IOC_ISR2TASK */
+#endif
+    OS_MAX_ISR2
+};
+#define OS_ISR_NONE             0xFFu
+
+/* ID schedule table (cấu hình trong Setup_SchTbl, os_kernel.c) */
+enum {
+    SCHTBL_MAIN = 0u,       /* Task_B định kỳ (log, chẩn đoán) */
+    SCHTBL_MODE_NORMAL,     /* chế độ xe: mỗi bảng là TOÀN BỘ kích hoạt */
+    SCHTBL_MODE_WARNING,    /* của chế độ đó – đổi chế độ bằng            */
+    SCHTBL_MODE_OFF,        /* NextSchedulTbl()                           */
+    OS_MAX_SchedTbl
+};
+#define OS_SCHTBL_NONE          0xFFu
+
+/* ID coroutine (bảng cấu hình tĩnh nằm trong os_pt.c) */
+enum {
+    PT_BUTTON_LED = 0u,     /* nhấn nút → nháy LED A */
+#ifdef APP_BENCH
+    PT_BENCH,               /* benchmark: pong cho BENCH_PT_RTT */
+#endif
+    OS_MAX_PT
+};
+/* ID kênh IOC (bảng cấu hình tĩnh nằm trong os_ioc.c) */
+enum {
+    IOC_BUTTON = 0u,        /* Task_C → Task_B: số lần nhấn nút (queued) */
+#ifdef APP_BENCH
+    IOC_BENCH_Q,            /* benchmark: queued */
+    IOC_BENCH_LIB,          /* benchmark: last-is-best */
+    IOC_BENCH_RX,           /* benchmark: ISR/Task_Init → TASK_BENCH0 (báo bằng event) */
+#endif
+    OS_MAX_IOC
+};
+#ifdef APP_BENCH
+#  define EVENT_BENCH_IOC       0x04000000u  /* IOC_BENCH_RX có dữ liệu */
+#endif
+/* ID pool khối cố định (bảng cấu hình tĩnh nằm trong os_pool.c) */
+enum {
+    POOL_16 = 0u,           /* 16 byte: CAN frame, bản ghi nhỏ */
+    POOL_32,                /* 32 byte: UART frame ngắn        */
+    POOL_64,                /* 64 byte: UART frame dài / log   */
+    OS_MAX_POOL
+};
+/* ID message queue chặn (bảng cấu hình tĩnh nằm trong os_msgq.c) */
+#ifdef APP_BENCH
+#  define OS_MAX_MSGQ           2u
+#else
+#  define OS_MAX_MSGQ           0u   /* ứng dụng chưa dùng → không tốn RAM */
+#endif
+#if (OS_MAX_MSGQ > 0u) && !(OS_CFG_EVENTS)
+#  error "blocking message queues need OS_CC_ECC1"
+#endif
+enum {
+    MSGQ_BENCH_REQ = 0u,    /* benchmark round-trip: yêu cầu */
+    MSGQ_BENCH_RSP = 1u     /* benchmark round-trip: trả lời */
 };
 typedef enum{
     MODE_NORMAL,
@@ -38,9 +354,19 @@ typedef enum{
 typedef enum{
     ST_STOP,
     ST_WAITING_START,
-    ST_RUNNING
+    ST_RUNNING,
+    ST_NEXT                 /* chờ bảng trước hết chu kỳ (NextSchedulTbl) */
 
 }SchedTblState;
+/* Trạng thái bảng cho ứng dụng (GetSchedulTblStatus) */
+typedef enum{
+    SCHEDULETABLE_STOPPED,
+    SCHEDULETABLE_NEXT,                     /* sẽ chạy khi bảng trước hết chu kỳ */
+    SCHEDULETABLE_WAITING,                  /* đã Start, chưa tới mốc bắt đầu */
+    SCHEDULETABLE_RUNNING,                  /* chạy; chưa đồng bộ / lệch > precision */
+    SCHEDULETABLE_RUNNING_AND_SYNCHRONOUS   /* đã SyncSchedulTbl, |lệch| ≤ precision */
+}ScheduleTableStatusType;
+typedef ScheduleTableStatusType *ScheduleTableStatusRefType;
 /* Trạng thái Task đơn giản */
 typedef enum {
     OS_DORMANT = 0,   /* "ngủ" - chưa sẵn sàng chạy */
@@ -49,41 +375,94 @@ typedef enum {
     OS_Waiting = 3
 } OsTaskState_e;
 
-/* Hành động mà alarm muốn sử dụng*/
+/* Hành động của alarm / expiry point, phân giải sẵn lúc cấu hình
+ * (OS_ACT_* trong os_kernel.c): ISR tick chỉ gọi fn(id, arg, dl).
+ *  - id : task đích (ActivateTask/SetEvent/timeout chờ) hoặc slot task
+ *         timer (callback) – nằm ở struct chủ, cạnh các field uint8_t
+ *  - arg: mask (SetEvent) hoặc con trỏ callback
+ *  - dl : deadline tương đối cho ActivateTask (tick) */
+typedef void (*OsActionFn)(uint8_t id, uintptr_t arg, TickType dl);
+typedef struct {
+    OsActionFn fn;
+    uintptr_t  arg;
+} OsAction_t;
+
+/* Alarm lặp bị trễ ≥ 1 chu kỳ (tickless, vùng tới hạn dài, bù tick):
+ * xử lý các chu kỳ đã lỡ thế nào. Mốc kế tiếp LUÔN tính từ mốc danh
+ * nghĩa (expiry += n*cycle) nên chu kỳ không trôi dù chọn cách nào. */
 typedef enum{
-    ALARMACTION_ACTIVATETASK,
-    ALARMACTION_SETEVENT,
-    ALARMACTION_CALLBACK
-}AlarmActionType;
+    ALARM_CATCHUP_ALL = 0,  /* kích đủ mọi chu kỳ đã lỡ (liên tiếp)      */
+    ALARM_CATCHUP_ONCE,     /* kích 1 lần cho cả loạt, đếm phần lỡ      */
+    ALARM_CATCHUP_SKIP      /* bỏ hết chu kỳ đã lỡ, chờ mốc kế tiếp     */
+}AlarmCatchupType;
+
+struct TCB;
+
+/* Thống kê bảo vệ thời gian của 1 task (chu kỳ CPU) */
+typedef struct {
+    uint32_t budget;        /* ngân sách / lần kích hoạt (0 = không giới hạn) */
+    uint32_t exec_last;     /* thời gian thực thi lần kích hoạt gần nhất */
+    uint32_t exec_max;      /* lớn nhất – so với budget để biết còn dư bao nhiêu */
+    uint32_t overruns;      /* số lần vượt ngân sách */
+    uint32_t arrivals;      /* số lần kích hoạt bị từ chối vì quá sớm */
+} OsTaskTimingStats_t;
+
+/* Danh sách task đang chờ 1 đối tượng (message queue...):
+ * nối qua TCB.next, sắp theo ưu tiên giảm dần (cùng ưu tiên → FIFO). */
+typedef struct {
+    struct TCB *head;
+} OsWaitQ_t;
 
 /* Khối điều khiển Task (TCB) – field ĐẦU TIÊN phải là 'sp'
  * để khớp với trình xử lý PendSV (ASM) dựa trên quy ước &R4. */
 typedef struct TCB {
     uint32_t         *sp;     /* &R4 (đầu SW-frame) của stack task */
-    struct TCB       *next;   /* (không bắt buộc) link nhanh, tùy bạn dùng */
+#if (OS_CFG_EVENTS)
+    struct TCB       *next;   /* link trong OsWaitQ_t khi đang chờ */
+#endif
     TaskType          id;     /* ID task */
     volatile uint8_t  state;  /* OsTaskState_e */
+    uint8_t           prio;   /* ưu tiên tĩnh: số lớn = ưu tiên cao */
+#if (OS_CFG_EVENTS)
+    volatile uint8_t  wait_rc;/* OS_WAIT_OK / OS_WAIT_TIMEOUT */
     EventMaskType    SetEvent;
     EventMaskType    WaitEvent;
+#endif
     uint8_t          isExtended;
+#if (OS_CFG_EVENTS)
+    OsWaitQ_t       *wait_q;    /* danh sách chờ đang đứng (NULL = chờ event) */
+    void            *wait_data; /* bộ đệm của task chờ (hand-off trực tiếp) */
+#endif
+#if (OS_CFG_DEADLINE_MON)
+    TickType         deadline;  /* mốc tuyệt đối (s_tick) của lần kích hoạt hiện tại */
+#endif
+#if (OS_CFG_ISR_LATENCY)
+    uint8_t          rdy_isr;   /* ISR loại 2 đã làm task READY (OS_ISR_NONE nếu không) */
+    uint32_t         rdy_stamp; /* CYCCNT lúc vào ISR đó */
+#endif
 } TCB_t;
 
 /* Bảng Alarm rất tối giản: kích hoạt Task theo chu kỳ */
 typedef struct {
     uint8_t  active;       /* 1=đang hoạt động */
-    uint32_t remain_ms;    /* còn lại bao nhiêu ms sẽ kích */
-    uint32_t cycle_ms;     /* chu kỳ (0 = one-shot) */
-    AlarmActionType action_type;
-    union{
-        uint8_t  target_task;  /* Task đích cần Activate */
-        struct{
-            TaskType task_id;
-            EventMaskType mask  
-        } Set_event;
-        void(*callback)(void);
-    }action;
+    uint8_t  catchup;      /* AlarmCatchupType */
+    uint8_t  act_id;       /* id của action (OsActionFn) */
+    TickType expiry;       /* mốc hết hạn tuyệt đối (tick hệ thống, tràn vòng) */
+    uint32_t cycle_ms;     /* chu kỳ theo tick (0 = one-shot) */
+    /* Thống kê (chỉ ISR tick ghi) */
+    uint32_t late_last;    /* trễ lần kích gần nhất (tick) */
+    uint32_t late_max;     /* trễ lớn nhất (tick) */
+    uint32_t missed;       /* số chu kỳ bị gộp (ONCE) hoặc bỏ (SKIP) */
+    OsAction_t action;
 } OsAlarm_t;
 
+/* Ảnh chụp thống kê của 1 alarm (GetAlarmStats) */
+typedef struct {
+    uint32_t late_last;
+    uint32_t late_max;
+    uint32_t missed;
+} OsAlarmStats_t;
+
 typedef struct
 {
     uint32_t current_value;
@@ -97,16 +476,12 @@ typedef struct
 typedef struct 
 {
     TickType offset;
-    enum {SCH_ACTIVATE_TASK, SCH_SET_EVENT, SCH_CALLBACK} action_type;
-    union{
-        TaskType tid;
-        struct 
-        {
-            TaskType tid;
-            EventMaskType mask;
-        } Set_event;
-        void (*callback_fn)(void);
-    } action;
+    /* Đồng bộ: khoảng SAU expiry point này được rút ngắn / kéo dài tối
+     * đa bấy nhiêu tick mỗi chu kỳ để bù độ lệch (0 = không chỉnh) */
+    uint16_t max_advance;
+    uint16_t max_retard;
+    OsAction_t action;
+    uint8_t  act_id;        /* id của action (OsActionFn) */
 } Expiry_Point;
 
 typedef struct 
@@ -119,5 +494,9 @@ typedef struct
     uint8_t num_eps;
     Expiry_Point eps[OS_MAX_EXPIRY_POINT];
     OsCounter_t* counter;
+    TickType precision;     /* |lệch| ≤ precision → đồng bộ */
+    int32_t  deviation;     /* vị trí bảng - thời gian ngoài (>0: bảng đi trước) */
+    uint8_t  sync_on;       /* đã nhận ít nhất 1 SyncSchedulTbl từ lần Start */
+    uint8_t  next;          /* bảng nối tiếp (OS_SCHTBL_NONE nếu không) */
 }OsSchedTbl;
 
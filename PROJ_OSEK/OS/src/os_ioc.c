@@ -0,0 +1,169 @@
+/*
+ * =====================================================================
+ *  IOC – hiện thực kênh SPSC wait-free
+ *  - QUEUED: chỉ số chạy tự do (free-running), & (depth-1) khi truy cập.
+ *      producer: ghi phần tử → DMB → tail++
+ *      consumer: đọc tail → DMB → chép phần tử → DMB → head++
+ *  - LAST_IS_BEST: 3 slot {back, mid, front}
+ *      producer: ghi slot back → DMB → back = xchg(mid, back | FRESH)
+ *      consumer: nếu mid có FRESH → front = xchg(mid, front) → chép slot front
+ * =====================================================================
+ */
+
+#include "os_ioc.h"
+#include "os_atomic.h"
+#include "os_internal.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define IOC_FRESH       0x4u    /* bit trong 'mid': slot giữa có dữ liệu mới */
+#define IOC_SLOT_MASK   0x3u
+
+/* =========================================================
+ *  Cấu hình kênh (tĩnh)
+ * ========================================================= */
+static uint8_t ioc_buf_button[8u * sizeof(uint32_t)];
+#ifdef APP_BENCH
+static uint8_t ioc_buf_bench_q[64u * sizeof(uint32_t)];
+static uint8_t ioc_buf_bench_lib[3u * 16u];
+static uint8_t ioc_buf_bench_rx[4u * sizeof(uint32_t)];
+#endif
+
+static const OsIocCfg_t ioc_cfg[OS_MAX_IOC] = {
+    [IOC_BUTTON] = {
+        .kind = IOC_QUEUED, .elem_size = sizeof(uint32_t), .depth = 8u,
+        .buf = ioc_buf_button,
+        .notify_task = TASK_B, .notify_mask = EVENT_BUTTON_PRESSED
+    },
+#ifdef APP_BENCH
+    [IOC_BENCH_Q] = {
+        .kind = IOC_QUEUED, .elem_size = sizeof(uint32_t), .depth = 64u,
+        .buf = ioc_buf_bench_q,
+        .notify_task = OS_IOC_NO_NOTIFY, .notify_mask = 0u
+    },
+    [IOC_BENCH_LIB] = {
+        .kind = IOC_LAST_IS_BEST, .elem_size = 16u, .depth = 3u,
+        .buf = ioc_buf_bench_lib,
+        .notify_task = OS_IOC_NO_NOTIFY, .notify_mask = 0u
+    },
+    [IOC_BENCH_RX] = {
+        .kind = IOC_QUEUED, .elem_size = sizeof(uint32_t), .depth = 4u,
+        .buf = ioc_buf_bench_rx,
+        .notify_task = TASK_BENCH0, .notify_mask = EVENT_BENCH_IOC
+    },
+#endif
+};
+
+/* back=0, mid=1, front=2 (chỉ có ý nghĩa với LAST_IS_BEST) */
+static OsIocRt_t ioc_rt[OS_MAX_IOC] = {
+    [0 ... (OS_MAX_IOC - 1u)] = { .mid = 1u, .back = 0u, .front = 2u }
+};
+
+static inline void ioc_copy(uint8_t *dst, const uint8_t *src, uint8_t n)
+{
+    while (n--) {
+        *dst++ = *src++;
+    }
+}
+
+/* Bên nhận DORMANT (task cơ bản đã kết thúc) → không báo, không lỗi:
+ * nó tự rút kênh ở lần kích hoạt kế (event bị xoá khi kích hoạt) */
+static inline void ioc_notify(const OsIocCfg_t *c)
+{
+#if (OS_CFG_EVENTS)
+    if (c->notify_task != OS_IOC_NO_NOTIFY) {
+        os_notify_event(c->notify_task, c->notify_mask);
+    }
+#else
+    (void)c;            /* BCC1: bên nhận tự thăm dò kênh */
+#endif
+}
+
+/* =========================================================
+ *  QUEUED
+ * ========================================================= */
+uint8_t IocSend(uint8_t ioc_id, const void *data)
+{
+    if (ioc_id >= OS_MAX_IOC || ioc_cfg[ioc_id].kind != IOC_QUEUED)
+        return IOC_E_LIMIT;
+
+    const OsIocCfg_t *c = &ioc_cfg[ioc_id];
+    OsIocRt_t *r = &ioc_rt[ioc_id];
+    uint32_t t = r->tail;
+
+    if ((t - r->head) >= c->depth) {
+        r->lost++;                  /* chỉ producer ghi 'lost' */
+        return IOC_E_LOST_DATA;
+    }
+
+    ioc_copy(&c->buf[(t & (c->depth - 1u)) * c->elem_size], (const uint8_t *)data, c->elem_size);
+    __DMB();                        /* dữ liệu phải thấy trước tail */
+    r->tail = t + 1u;
+
+    ioc_notify(c);
+    return IOC_E_OK;
+}
+
+uint8_t IocReceive(uint8_t ioc_id, void *data)
+{
+    if (ioc_id >= OS_MAX_IOC || ioc_cfg[ioc_id].kind != IOC_QUEUED)
+        return IOC_E_LIMIT;
+
+    const OsIocCfg_t *c = &ioc_cfg[ioc_id];
+    OsIocRt_t *r = &ioc_rt[ioc_id];
+    uint32_t h = r->head;
+
+    if (h == r->tail)
+        return IOC_E_NO_DATA;
+    __DMB();                        /* đọc dữ liệu SAU khi thấy tail */
+
+    ioc_copy((uint8_t *)data, &c->buf[(h & (c->depth - 1u)) * c->elem_size], c->elem_size);
+    __DMB();                        /* chép xong mới trả slot */
+    r->head = h + 1u;
+    return IOC_E_OK;
+}
+
+/* =========================================================
+ *  LAST_IS_BEST
+ * ========================================================= */
+uint8_t IocWrite(uint8_t ioc_id, const void *data)
+{
+    if (ioc_id >= OS_MAX_IOC || ioc_cfg[ioc_id].kind != IOC_LAST_IS_BEST)
+        return IOC_E_LIMIT;
+
+    const OsIocCfg_t *c = &ioc_cfg[ioc_id];
+    OsIocRt_t *r = &ioc_rt[ioc_id];
+
+    ioc_copy(&c->buf[r->back * c->elem_size], (const uint8_t *)data, c->elem_size);
+    __DMB();
+    r->back = (uint8_t)(os_atomic_xchg32(&r->mid, r->back | IOC_FRESH) & IOC_SLOT_MASK);
+
+    ioc_notify(c);
+    return IOC_E_OK;
+}
+
+uint8_t IocRead(uint8_t ioc_id, void *data)
+{
+    if (ioc_id >= OS_MAX_IOC || ioc_cfg[ioc_id].kind != IOC_LAST_IS_BEST)
+        return IOC_E_LIMIT;
+
+    const OsIocCfg_t *c = &ioc_cfg[ioc_id];
+    OsIocRt_t *r = &ioc_rt[ioc_id];
+
+    if (r->mid & IOC_FRESH) {
+        r->front = (uint8_t)(os_atomic_xchg32(&r->mid, r->front) & IOC_SLOT_MASK);
+        r->has_data = 1u;
+        __DMB();
+    }
+    if (!r->has_data)
+        return IOC_E_NO_DATA;
+
+    ioc_copy((uint8_t *)data, &c->buf[r->front * c->elem_size], c->elem_size);
+    return IOC_E_OK;
+}
+
+uint32_t IocGetLost(uint8_t ioc_id)
+{
+    return (ioc_id < OS_MAX_IOC) ? ioc_rt[ioc_id].lost : 0u;
+}
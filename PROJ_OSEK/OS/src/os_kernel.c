@@ -2,16 +2,24 @@
  * =====================================================================
  *  Mini-OS Kernel Layer – phiên bản tối giản, chạy ổn định
  *  - READY queue: ring buffer có FULL/EMPTY
- *  - Alarm: SetRelAlarm(aid, delay_ms, cycle_ms, target_tid) (4 tham số)
+ *  - Alarm: SetRelAlarm(aid, delay_ms, cycle_ms) – đích nằm trong action
+ *           cấu hình sẵn của alarm (SetUpAlarm)
  *           Lưu runtime theo tick (ms → tick qua OS_TICK_HZ)
  *  - schedule(): chọn next; nếu rỗng → IDLE
  *  - Bootstrap: tạo INIT/A/B/IDLE và launch qua SVC
- *  - Chính sách: run-to-completion (chỉ preempt khi đang ở IDLE)
+ *  - Chính sách: run-to-completion (chỉ preempt khi đang ở IDLE),
+ *    round-robin giữa các task cùng ưu tiên khi bật OS_CFG_RR
+ *  - Callback Alarm/Schedule Table: hoãn sang TASK_TIMER (OS_CFG_TIMER_TASK),
+ *    timer đẩy task đang chạy ra ngay cuối ISR tick
  * =====================================================================
  */
 
 #include "os_kernel.h"
 #include "os_port.h" /* os_port_init(), os_task_stack_init(), os_trigger_pendsv(), OS_TICK_HZ */
+#include "os_pool.h" /* os_pool_init() */
+#include "os_internal.h"
+#include "os_isr.h"
+#include "os_perf.h"
 #include "stm32f10x.h"
 #include "cmsis_gcc.h"
 
@@ -27,6 +35,11 @@
 #if __STDC_VERSION__ >= 201112L
 _Static_assert(OS_MAX_TASKS >= 2, "OS_MAX_TASKS must be >= 2");
 _Static_assert(OS_MAX_TASKS <= 255, "OS_MAX_TASKS must be <= 255");
+_Static_assert(OS_MAX_TASKS <= 32, "task_group[] is a 32-bit task mask");
+_Static_assert(offsetof(TCB_t, sp) == 0u, "PendSV_Handler expects TCB_t.sp at offset 0");
+#if (OS_CFG_ALARM_CALLBACK)
+_Static_assert(OS_TIMER_SLOTS <= 256u, "callback slot is stored in a uint8_t act_id");
+#endif
 #endif
 
 /* =========================================================
@@ -34,6 +47,10 @@ _Static_assert(OS_MAX_TASKS <= 255, "OS_MAX_TASKS must be <= 255");
  * ========================================================= */
 volatile TCB_t *g_current = NULL;
 volatile TCB_t *g_next = NULL;
+/* Task vừa TerminateTask(): ngữ cảnh của nó sẽ bị dựng lại ở lần Activate
+ * kế tiếp → PendSV KHÔNG lưu R4..R11 / sp (PendSV tự xoá vé này). */
+volatile TCB_t *g_discard = NULL;
+volatile uint32_t g_os_preempt = 0u;
 
 /* =========================================================
  *  Vùng TCB & Stack (ứng dụng mẫu 4 task: INIT/A/B/IDLE)
@@ -46,12 +63,26 @@ static TCB_t tcb[OS_MAX_TASKS];
 #define STACK_WORDS_B 96u
 #define STACK_WORDS_C 96u
 #define STACK_WORDS_IDLE 64u
+#define STACK_WORDS_D 96u
+#define STACK_WORDS_TIMER 128u
+#define STACK_WORDS_PT 96u     /* chung cho mọi coroutine */
+#define STACK_WORDS_BENCH 64u
 
 static uint32_t stack_init[STACK_WORDS_INIT];
 static uint32_t stack_a[STACK_WORDS_A];
 static uint32_t stack_b[STACK_WORDS_B];
 static uint32_t stack_c[STACK_WORDS_C];
 static uint32_t stack_idle[STACK_WORDS_IDLE];
+static uint32_t stack_d[STACK_WORDS_D];
+#if (OS_CFG_TIMER_TASK)
+static uint32_t stack_timer[STACK_WORDS_TIMER];
+#endif
+#if (OS_CFG_PT)
+static uint32_t stack_pt[STACK_WORDS_PT];
+#endif
+#ifdef APP_BENCH
+static uint32_t stack_bench[OS_BENCH_TASKS][STACK_WORDS_BENCH];
+#endif
 OsCounter_t Counter_tbl[OS_MAX_COUNTER]={
     // counter 0
     {
@@ -73,11 +104,18 @@ OsCounter_t Counter_tbl[OS_MAX_COUNTER]={
 
 };
 /* =========================================================
- *  READY Queue (ring buffer) – chừa 1 ô để phân biệt FULL/EMPTY
+ *  READY Queue
+ *   - FIFO (mặc định): ring buffer – chừa 1 ô để phân biệt FULL/EMPTY
+ *   - EDF (OS_CFG_EDF): min-heap theo TCB.deadline
  * ========================================================= */
+#if (OS_CFG_EDF)
+static uint8_t ready_q[OS_MAX_TASKS];   /* heap: ready_q[0] = deadline sớm nhất */
+static uint8_t rq_n = 0u;
+#else
 static uint8_t ready_q[OS_MAX_TASKS];
 static uint8_t rq_head = 0u; /* vị trí pop */
 static uint8_t rq_tail = 0u; /* vị trí push */
+#endif
 
 
 typedef void (*TaskEntry)(void *);
@@ -85,12 +123,181 @@ typedef void (*TaskEntry)(void *);
 static TaskEntry g_task_entry[OS_MAX_TASKS];
 static void     *g_task_arg  [OS_MAX_TASKS];
 static uint32_t *g_stack_top [OS_MAX_TASKS];
+static uint32_t *g_task_frame[OS_MAX_TASKS];   /* khung ban đầu (&R4), dựng 1 lần ở OS_Init */
+
+#if (OS_CFG_EVENTS)
+/* Nhóm task cho SetEventGroup(): bitmask (1 << TaskId) */
+static const uint32_t task_group[OS_MAX_TASKGROUP] = {
+    [TASKGROUP_MODE]  = (1u << TASK_B),
+#ifdef APP_BENCH
+    [TASKGROUP_BENCH8]  = 0x00FFu << TASK_BENCH0,
+    [TASKGROUP_BENCH16] = 0xFFFFu << TASK_BENCH0,
+#endif
+};
+#endif
+
+/* Resource nội: bitmask (1 << TaskId) các task thuộc nhóm */
+static const uint32_t ires_members[OS_MAX_IRES] = {
+#if (OS_CFG_IRES)
+    [IRES_IO] = (1u << TASK_B) | (1u << TASK_C),
+#endif
+};
+static uint32_t ires_tasks;     /* hợp mọi nhóm, tính ở OS_Init */
+
+/* Ưu tiên tĩnh (số lớn = ưu tiên cao). Dùng để sắp danh sách chờ. */
+static const uint8_t g_task_prio[OS_MAX_TASKS] = {
+    [TASK_INIT] = 4u,
+    [TASK_A]    = 3u,
+    [TASK_B]    = 2u,
+    [TASK_C]    = 2u,
+    [TASK_IDLE] = 0u,
+    [TASK_D]    = 2u,
+#if (OS_CFG_TIMER_TASK)
+    [TASK_TIMER] = OS_TIMER_TASK_PRIO,
+#endif
+#if (OS_CFG_PT)
+    [TASK_PT]    = OS_PT_TASK_PRIO,
+#endif
+#ifdef APP_BENCH
+    [TASK_BENCH0 ... (TASK_BENCH0 + OS_BENCH_TASKS - 1u)] = 1u,
+#endif
+};
+
+#if (OS_CFG_DEADLINE_MON)
+/* Deadline tương đối (tick) cho ActivateTask/ChainTask. Alarm lặp dùng
+ * mốc kế tiếp của nó (deadline = chu kỳ), expiry point dùng khoảng tới
+ * expiry point kế tiếp của bảng. Task timer = 0: luôn đứng đầu EDF. */
+static const TickType g_task_deadline[OS_MAX_TASKS] = {
+    [TASK_INIT] = 1000u,
+    [TASK_A]    = 50u,
+    [TASK_B]    = 5000u,
+    [TASK_C]    = 50u,
+    [TASK_IDLE] = 0u,       /* không vào READY queue */
+    [TASK_D]    = 1000u,
+#if (OS_CFG_TIMER_TASK)
+    [TASK_TIMER] = 0u,
+#endif
+#if (OS_CFG_PT)
+    [TASK_PT]    = 100u,
+#endif
+#ifdef APP_BENCH
+    [TASK_BENCH0 ... (TASK_BENCH0 + OS_BENCH_TASKS - 1u)] = 1000u,
+#endif
+};
+
+/* Task vòng lặp của kernel (kích 1 lần ở OS_Init, không kết thúc): mỗi
+ * lần thức coi như 1 lần kích mới → task_wake đặt lại deadline. Task
+ * khác giữ deadline của lần kích (alarm/expiry point) tới dl_finish. */
+static const uint32_t dl_restamp_tasks = 0u
+#if (OS_CFG_TIMER_TASK)
+    | (1u << TASK_TIMER)
+#endif
+#if (OS_CFG_PT)
+    | (1u << TASK_PT)
+#endif
+    ;
+#endif
+
+
+#if (OS_CFG_EDF)
+/* a chạy trước b: deadline sớm hơn (so sánh có dấu → đúng khi tick tràn) */
+static inline bool dl_before(uint8_t a, uint8_t b)
+{
+    return (int32_t)(tcb[a].deadline - tcb[b].deadline) < 0;
+}
+
+static inline void rq_reset(void)
+{
+    rq_n = 0u;
+}
 
+static inline bool rq_empty(void)
+{
+    return (rq_n == 0u);
+}
+
+static inline bool rq_push(uint8_t tid)
+{
+    if (rq_n >= OS_MAX_TASKS)
+        return false;
+    uint8_t i = rq_n++;
+    while (i > 0u) {                    /* sift-up */
+        uint8_t p = (uint8_t)((i - 1u) / 2u);
+        if (!dl_before(tid, ready_q[p]))
+            break;
+        ready_q[i] = ready_q[p];
+        i = p;
+    }
+    ready_q[i] = tid;
+    return true;
+}
+
+/* Ưu tiên khẩn đã nằm trong deadline (rel = 0) → không cần chen đầu */
+static inline bool rq_push_task(uint8_t tid)
+{
+    return rq_push(tid);
+}
+
+static inline bool rq_pop_raw(uint8_t *out_tid)
+{
+    if (rq_empty())
+        return false;
+    *out_tid = ready_q[0];
+    uint8_t last = ready_q[--rq_n];
+    uint8_t i = 0u;
+    for (;;) {                          /* sift-down */
+        uint8_t c = (uint8_t)(2u * i + 1u);
+        if (c >= rq_n)
+            break;
+        if ((c + 1u < rq_n) && dl_before(ready_q[c + 1u], ready_q[c]))
+            c++;
+        if (!dl_before(ready_q[c], last))
+            break;
+        ready_q[i] = ready_q[c];
+        i = c;
+    }
+    ready_q[i] = last;
+    return true;
+}
+
+/* t được chạy trước mọi task đang READY (ChainTask hand-off) */
+static bool rq_outranked_by(const TCB_t *t)
+{
+    return rq_empty() || !dl_before(ready_q[0], t->id);
+}
+
+/* Schedule(): cur nhường nếu đầu heap có deadline sớm hơn (cur về heap) */
+static bool rq_yield(TCB_t *cur)
+{
+    if (rq_empty() || !dl_before(ready_q[0], cur->id))
+        return false;
+    return rq_push(cur->id);
+}
+#else
+#if (OS_CFG_RR)
+/* Số task READY theo mức ưu tiên (mức > OS_PRIO_URGENT không có lượt
+ * RR → không đếm): rr_tick biết có task cùng mức trong O(1) */
+static uint8_t rq_prio_n[OS_PRIO_URGENT + 1u];
+
+static inline void rq_count(uint8_t tid, uint8_t inc)
+{
+    uint8_t p = tcb[tid].prio;
+    if (p <= OS_PRIO_URGENT)
+        rq_prio_n[p] = inc ? (uint8_t)(rq_prio_n[p] + 1u) : (uint8_t)(rq_prio_n[p] - 1u);
+}
+#else
+#  define rq_count(tid, inc)    ((void)0)
+#endif
 
 static inline void rq_reset(void)
 {
     rq_head = 0u;
     rq_tail = 0u;
+#if (OS_CFG_RR)
+    for (uint8_t p = 0u; p <= OS_PRIO_URGENT; ++p) {
+        rq_prio_n[p] = 0u;
+    }
+#endif
 }
 
 static inline bool rq_empty(void)
@@ -111,10 +318,27 @@ static inline bool rq_push(uint8_t tid)
         return false;
     ready_q[rq_tail] = tid;
     rq_tail = (uint8_t)((rq_tail + 1u) % OS_MAX_TASKS);
+    rq_count(tid, 1u);
     return true;
 }
 
-uint8_t test = 0;
+static inline bool rq_push_front(uint8_t tid)
+{
+    if (rq_full())
+        return false;
+    rq_head = (uint8_t)((rq_head + OS_MAX_TASKS - 1u) % OS_MAX_TASKS);
+    ready_q[rq_head] = tid;
+    rq_count(tid, 1u);
+    return true;
+}
+
+/* Task ưu tiên ≥ OS_PRIO_URGENT chen đầu queue, còn lại FIFO */
+static inline bool rq_push_task(uint8_t tid)
+{
+    if (tcb[tid].prio < OS_PRIO_URGENT)
+        return rq_push(tid);
+    return rq_push_front(tid);
+}
 
 static inline bool rq_pop_raw(uint8_t *out_tid)
 {
@@ -122,20 +346,90 @@ static inline bool rq_pop_raw(uint8_t *out_tid)
         return false;
     *out_tid = ready_q[rq_head];
     rq_head = (uint8_t)((rq_head + 1u) % OS_MAX_TASKS);
+    rq_count(*out_tid, 0u);
+    return true;
+}
+
+/* t được chạy trước mọi task đang READY (ChainTask hand-off) */
+static bool rq_outranked_by(const TCB_t *t)
+{
+    for (uint8_t i = rq_head; i != rq_tail; i = (uint8_t)((i + 1u) % OS_MAX_TASKS)) {
+        if (tcb[ready_q[i]].prio >= t->prio)
+            return false;
+    }
     return true;
 }
 
+/* Schedule(): task READY đầu tiên có ưu tiên cao hơn cur được rút khỏi
+ * ring (phần trước nó dồn lùi 1 ô) rồi đặt lên đầu, cur ngay sau →
+ * schedule() chọn nó, xong tới lượt cur (chưa tới các task khác). */
+static bool rq_yield(TCB_t *cur)
+{
+    for (uint8_t i = rq_head; i != rq_tail; i = (uint8_t)((i + 1u) % OS_MAX_TASKS)) {
+        uint8_t tid = ready_q[i];
+        if (tcb[tid].prio <= cur->prio)
+            continue;
+        while (i != rq_head) {
+            uint8_t p = (uint8_t)((i + OS_MAX_TASKS - 1u) % OS_MAX_TASKS);
+            ready_q[i] = ready_q[p];
+            i = p;
+        }
+        rq_head = (uint8_t)((rq_head + 1u) % OS_MAX_TASKS);
+        rq_count(tid, 0u);              /* rq_push_front đếm lại */
+        (void)rq_push_front(cur->id);   /* cur không nằm trong ring → luôn còn chỗ */
+        (void)rq_push_front(tid);
+        return true;
+    }
+    return false;
+}
+
+#if (OS_CFG_RR)
+/* Hết lượt RR: cur vào ngay sau task cùng mức đứng cuối trong ring (cuối
+ * mức ưu tiên của nó, không phải cuối cả queue) – task mức khác đến sau
+ * vẫn giữ thứ tự. Chỉ gọi khi rq_prio_n[cur->prio] != 0. */
+static void rq_rotate(TCB_t *cur)
+{
+    uint8_t i = rq_tail;
+    for (;;) {
+        uint8_t p = (uint8_t)((i + OS_MAX_TASKS - 1u) % OS_MAX_TASKS);
+        if (tcb[ready_q[p]].prio == cur->prio)
+            break;
+        i = p;
+    }
+    /* dồn [i, tail) lên 1 ô, chèn cur vào i (cur không nằm trong ring
+     * → luôn còn chỗ) */
+    for (uint8_t j = rq_tail; j != i; ) {
+        uint8_t p = (uint8_t)((j + OS_MAX_TASKS - 1u) % OS_MAX_TASKS);
+        ready_q[j] = ready_q[p];
+        j = p;
+    }
+    ready_q[i] = cur->id;
+    rq_tail = (uint8_t)((rq_tail + 1u) % OS_MAX_TASKS);
+    rq_count(cur->id, 1u);
+}
+#endif
+#endif
+
+uint8_t test = 0;
+
 /* =========================================================
  *  Alarm runtime & Tick Counter
- *  (OsAlarm_t do bạn khai báo trong os_kernel.h:
- *   active, target_task, remain_ms, cycle_ms)
- *  LƯU Ý: remain_ms/cycle_ms SẼ LƯU THEO TICK (đã quy đổi)
+ *  (OsAlarm_t do bạn khai báo trong os_types.h:
+ *   active, catchup, expiry, cycle_ms, thống kê trễ)
+ *  LƯU Ý: expiry là mốc TUYỆT ĐỐI trên s_tick; cycle_ms LƯU THEO TICK
  * ========================================================= */
 
 static volatile uint32_t s_tick = 0;
 static OsAlarm_t alarm_tbl[OS_MAX_ALARMS];
+#if (OS_CFG_EVENTS)
+/* Timer chờ của từng task (action task_timeout): dùng chung cơ chế Alarm,
+ * bật trong os_wait_current(), huỷ O(1) trong os_release_task(). */
+static OsAlarm_t task_tmo[OS_MAX_TASKS];
+#endif
 OsCounter_t *alarm_to_counter[OS_MAX_ALARMS];
+#if (OS_CFG_SCHTBL)
 OsSchedTbl Schedule_Table_List[OS_MAX_SchedTbl];
+#endif
 /* Quy đổi ms → tick (làm tròn lên, tối thiểu 1 tick nếu ms>0) */
 static inline uint32_t ms_to_ticks(uint32_t ms)
 {
@@ -149,6 +443,22 @@ static inline uint32_t ms_to_ticks(uint32_t ms)
     return (uint32_t)t;
 }
 
+/* =========================================================
+ *  Deadline (OS_CFG_DEADLINE_MON)
+ * ========================================================= */
+#define OS_DL_DEFAULT   0xFFFFFFFFu     /* task_activate: dùng g_task_deadline */
+
+#if (OS_CFG_DEADLINE_MON)
+static uint32_t dl_miss[OS_MAX_TASKS];
+
+/* Lần kích hoạt của t kết thúc: quá deadline → đếm */
+static inline void dl_finish(const TCB_t *t)
+{
+    if ((int32_t)(s_tick - t->deadline) > 0)
+        dl_miss[t->id]++;
+}
+#endif
+
 /* =========================================================
  *  Khai báo thân Task do ứng dụng cung cấp
  * ========================================================= */
@@ -157,11 +467,116 @@ extern void Task_A(void *arg);
 extern void Task_B(void *arg);
 extern void Task_C(void *arg);
 extern void Task_Idle(void *arg);
+extern void Task_D(void *arg);
 
 
 extern void SetMode_Normal(void);
 extern void SetMode_Warning(void);
 extern void SetMode_Off(void);
+extern void Mode_LedOff(void);
+#ifdef APP_BENCH
+extern void Bench_SlowCallback(void);
+extern void Bench_Task(void *arg);
+#endif
+/* =========================================================
+ *  ISR loại 2: bộ đếm lồng + đo độ trễ ISR → dispatch
+ * ========================================================= */
+static volatile uint8_t os_isr_nest;
+static volatile uint8_t os_dispatch_pending;
+#if (OS_CFG_ISR_LATENCY)
+static volatile uint8_t  os_isr_cur = OS_ISR_NONE;  /* ISR2 trong cùng đang chạy */
+static volatile uint32_t os_isr_stamp;              /* CYCCNT lúc vào ISR đó   */
+static OsPerf_t isr_lat[OS_MAX_ISR2];
+#endif
+
+/* Task vừa READY: ghi lại ISR gây ra (nếu có) */
+static inline void isr_mark_ready(TCB_t *t)
+{
+#if (OS_CFG_ISR_LATENCY)
+    t->rdy_isr   = (os_isr_nest != 0u) ? os_isr_cur : OS_ISR_NONE;
+    t->rdy_stamp = os_isr_stamp;
+#else
+    (void)t;
+#endif
+}
+
+/* Task được dispatch: cộng độ trễ vào thống kê của ISR đã làm nó READY */
+static inline void isr_account_dispatch(TCB_t *t)
+{
+#if (OS_CFG_ISR_LATENCY)
+    if (t->rdy_isr != OS_ISR_NONE) {
+        os_perf_add(&isr_lat[t->rdy_isr], os_perf_now() - t->rdy_stamp);
+        t->rdy_isr = OS_ISR_NONE;
+    }
+#else
+    (void)t;
+#endif
+}
+
+/* =========================================================
+ *  Trạng thái lỗi (StatusType) + ErrorHook
+ *   - OS_ERROR : lỗi có ở cả STANDARD status → luôn trả về (+ hook)
+ *   - OS_CHECK : kiểm tra chỉ có ở EXTENDED status; STANDARD → biến
+ *                mất khỏi mã (đường nhanh không tốn lệnh nào)
+ *   - Gọi OS_ERROR khi IRQ đang MỞ (hook chạy ngoài vùng tới hạn)
+ * ========================================================= */
+__attribute__((weak)) void ErrorHook(StatusType error)
+{
+    (void)error;
+}
+
+#if (OS_CFG_ERROR_HOOK)
+static OSServiceIdType os_err_service;
+static uint32_t        os_err_param;
+static volatile uint8_t os_in_error_hook;
+
+OSServiceIdType OSErrorGetServiceId(void)
+{
+    return os_err_service;
+}
+
+uint32_t OSErrorGetParam1(void)
+{
+    return os_err_param;
+}
+
+static StatusType os_error(OSServiceIdType sid, uint32_t param, StatusType err)
+{
+    if (!os_in_error_hook) {        /* OSEK: ErrorHook không gọi lồng */
+        os_in_error_hook = 1u;
+        os_err_service = sid;
+        os_err_param   = param;
+        ErrorHook(err);
+        os_in_error_hook = 0u;
+    }
+    return err;
+}
+#  define OS_ERROR(sid, param, err)     os_error((sid), (uint32_t)(param), (err))
+#else
+#  define OS_ERROR(sid, param, err)     (err)
+#endif
+
+/* Hook OSEK: tham chiếu weak (ứng dụng không định nghĩa → địa chỉ 0) */
+#if (OS_CFG_HOOKS)
+extern void StartupHook(void) __attribute__((weak));
+extern void ShutdownHook(StatusType error) __attribute__((weak));
+extern void PreTaskHook(void) __attribute__((weak));
+extern void PostTaskHook(void) __attribute__((weak));
+#  define OS_HOOK(fn, ...)          do { if ((fn) != NULL) fn(__VA_ARGS__); } while (0)
+#else
+#  define OS_HOOK(fn, ...)          do { } while (0)
+#endif
+
+#if (OS_STATUS_EXTENDED)
+#  define OS_CHECK(cond, sid, param, err)                   \
+    do {                                                    \
+        if (!(cond))                                        \
+            return OS_ERROR((sid), (param), (err));         \
+    } while (0)
+#else
+#  define OS_CHECK(cond, sid, param, err)   do { } while (0)
+#endif
+
 /* =========================================================
  * schedule()
  * ---------------------------------------------------------
@@ -191,9 +606,16 @@ extern void SetMode_Off(void);
  * Trả về:
  *   - true luôn (vì nếu không có READY thì vẫn chọn IDLE).
  * ========================================================= */
+#ifdef APP_BENCH
+OsPerf_t g_os_sched_perf;
+#endif
+
 static bool schedule(void)
 {
     if (g_next != NULL) return true;
+#ifdef APP_BENCH
+    uint32_t t0 = os_perf_now();
+#endif
 
     uint8_t tid;
     TCB_t *next = NULL;
@@ -211,347 +633,1292 @@ static bool schedule(void)
             next = &tcb[TASK_IDLE];
         } else {
             next->state = OS_RUNNING;
+            if (next->sp == NULL) {     /* ChainTask(chính nó) đã xếp hàng */
+                next->sp = os_task_frame_rearm(g_task_frame[tid], g_task_entry[tid], g_task_arg[tid]);
+            }
+            isr_account_dispatch(next);
         }
     }
     g_next = next;
-    g_next->id = tid;
-    __DSB(); __ISB();
-    os_trigger_pendsv();
+    os_trigger_pendsv();    /* PendSV chạy khi caller mở IRQ / thoát ISR */
+#ifdef APP_BENCH
+    os_perf_add(&g_os_sched_perf, os_perf_now() - t0);
+#endif
     return true;
 }
 
 /* =========================================================
- *  ActivateTask(): DORMANT → READY (không kích chồng)
+ *  Điểm lập lịch sau khi có task READY mới (gọi khi IRQ TẮT)
+ *   - Trong ISR loại 2 (os_isr_nest > 0): chỉ ghi nhớ; quyết định
+ *     1 lần duy nhất ở os_isr_exit() của ISR ngoài cùng.
+ *   - Ngoài ISR: đang IDLE và chưa có vé → chọn ngay.
  * ========================================================= */
-void ActivateTask(uint8_t tid)
+static void os_dispatch(void)
 {
-    if (tid >= OS_MAX_TASKS || tid == TASK_IDLE) return;
-
-    __disable_irq();
-    TCB_t *t = &tcb[tid];
-    if (t->state == OS_DORMANT||t->state == OS_Waiting  ) {
-        /* *** Quan trọng: dựng lại PSP để task chạy lại từ đầu entry *** */
-        t->sp    = os_task_stack_init(g_task_entry[tid], g_task_arg[tid], g_stack_top[tid]);
-        t->state = OS_READY;
-        (void)rq_push(tid);
-
-        /* Fast-path: nếu đang Idle và chưa pending thì chuyển ngay (tuỳ bạn) */
-        if ((g_current == &tcb[TASK_IDLE]) && (g_next == NULL)) {
-            __DSB(); __ISB();
-            os_trigger_pendsv();
-        }
+#if (OS_CFG_DEFERRED_DISPATCH)
+    if (os_isr_nest != 0u) {
+        os_dispatch_pending = 1u;
+        return;
+    }
+#endif
+    if ((g_next == NULL) && (g_current == &tcb[TASK_IDLE])) {
+        (void)schedule();
     }
-    __enable_irq();
 }
 
-/* =========================================================
- *  TerminateTask(): Task tự kết thúc → DORMANT và chuyển lịch
- * ========================================================= */
-void TerminateTask(void)
+/* ISR lồng nhau luôn vào/ra theo kiểu LIFO → ++/-- và cặp cur/stamp
+ * (lưu trong khung của wrapper) không cần khoá */
+void os_isr_enter(OsIsrFrame_t *f, uint8_t isr_id)
 {
-    __disable_irq();
-
-    TCB_t *cur = (TCB_t *)g_current;
-    if (cur)
-    {
-        cur->state = OS_DORMANT;
-    }
-
-    (void)schedule(); /* chọn READY khác; nếu rỗng → IDLE */
-
-    __enable_irq();
-
-    /* Không quay lại thân task nữa */
-    for (;;)
-    {
-        __NOP();
-    }
+    os_isr_nest++;
+#if (OS_CFG_ISR_LATENCY)
+    f->prev_isr   = os_isr_cur;
+    f->prev_stamp = os_isr_stamp;
+    os_isr_stamp  = os_perf_now();
+    os_isr_cur    = isr_id;
+#else
+    (void)f;
+    (void)isr_id;
+#endif
 }
 
-/* =========================================================
- *  SetRelAlarm(aid, delay_ms, cycle_ms, target_tid) – 4 tham số
- *   - Lưu runtime theo tick (ms → tick)
- *   - Nếu đang active: ghi đè cấu hình mới
- * ========================================================= */
-void SetRelAlarm(uint8_t aid, uint32_t delay_ms, uint32_t cycle_ms, uint8_t target_tid)
+void os_isr_exit(OsIsrFrame_t *f)
 {
-    if (aid >= OS_MAX_ALARMS)
-        return;
-    if (target_tid >= OS_MAX_TASKS)
+#if (OS_CFG_ISR_LATENCY)
+    os_isr_cur   = f->prev_isr;
+    os_isr_stamp = f->prev_stamp;
+#else
+    (void)f;
+#endif
+    if (--os_isr_nest != 0u)
         return;
 
-    OsCounter_t *c = alarm_to_counter[aid];
-    uint32_t inc_ticks = ms_to_ticks(delay_ms == 0u ? 1u : delay_ms) % c->max_allowed_Value;
-    uint32_t cyc_ticks = ms_to_ticks(cycle_ms) % c->max_allowed_Value;
-    if ((cyc_ticks > 0u) && (cyc_ticks < 1u))
-    {
-        cyc_ticks = 1u; /* ép tối thiểu 1 tick nếu có chu kỳ */
-    }
-
+#if (OS_CFG_DEFERRED_DISPATCH)
     __disable_irq();
-    
-    OsAlarm_t *a = &alarm_tbl[aid];
-    a->active = 1u;
-    a->remain_ms = inc_ticks; /* LƯU THEO TICK */
-    a->cycle_ms = cyc_ticks;  /* LƯU THEO TICK */
-
+    if (os_dispatch_pending) {
+        os_dispatch_pending = 0u;
+        os_dispatch();
+    }
     __enable_irq();
+#endif
 }
-void SetAbsAlarm(uint8_t aid, uint32_t delay_ms, uint32_t cycle_ms, uint8_t target_tid){
-    if (aid >= OS_MAX_ALARMS)
-        return;
-    if (target_tid >= OS_MAX_TASKS)
+
+#if (OS_CFG_ISR_LATENCY)
+void GetIsrLatency(uint8_t isr_id, OsPerf_t *out, uint8_t reset)
+{
+    if (isr_id >= OS_MAX_ISR2 || out == NULL)
         return;
-    OsCounter_t *c = alarm_to_counter[aid];
-    uint32_t inc_ticks = ms_to_ticks(delay_ms == 0u ? 1u : delay_ms) % c->max_allowed_Value;
-    uint32_t cyc_ticks = ms_to_ticks(cycle_ms) % c->max_allowed_Value;
-    if ((cyc_ticks > 0u) && (cyc_ticks < 1u))
-    {
-        cyc_ticks = 1u; /* ép tối thiểu 1 tick nếu có chu kỳ */
-    }
+
     __disable_irq();
-    OsAlarm_t *a = &alarm_tbl[aid];
-    uint32_t delta;
-    uint32_t now = s_tick;
-    if(inc_ticks >= now){
-        delta = inc_ticks - now;
+    *out = isr_lat[isr_id];
+    if (reset) {
+        os_perf_reset(&isr_lat[isr_id]);
     }
-    else{
-        delta = (s_tick - now) + inc_ticks;
-    }
-    a->active = 1u;
-    a->remain_ms = delta;
-    a->cycle_ms = cyc_ticks;
     __enable_irq();
 }
+#endif
+
+/* Kết thúc lần kích hoạt của task đang chạy t (gọi khi IRQ TẮT):
+ * TerminateTask() và huỷ do hết ngân sách dùng chung */
+static void task_end(TCB_t *t)
+{
+#if (OS_CFG_DEADLINE_MON)
+    dl_finish(t);
+#endif
+    t->state = OS_DORMANT;
+    /* Ngữ cảnh này không bao giờ được tiếp tục: kể cả khi bị Activate
+     * lại trước khi PendSV chạy (sp đã dựng mới) → đừng ghi đè sp */
+    g_discard = t;
+    (void)schedule();   /* chọn READY khác; nếu rỗng → IDLE */
+}
+
 /* =========================================================
- *  os_on_tick(): gọi mỗi nhịp SysTick (ISR context)
- *   - Tăng tick, quét Alarm → ActivateTask() khi đến hạn
- *   - Run-to-completion: chỉ schedule ngay khi current là IDLE
+ *  Bảo vệ thời gian (OS_CFG_TIMING_PROT)
+ *   - Ngân sách: thời gian CPU của 1 lần kích hoạt, cộng dồn qua các
+ *     lần bị đổi ra (PendSV gọi os_tp_switch), đo bằng DWT->CYCCNT.
+ *     Khi task vào CPU: TIM2 compare = phần ngân sách còn lại.
+ *   - Khoảng tối thiểu giữa 2 lần kích hoạt (inter-arrival): kích hoạt
+ *     sớm hơn bị từ chối với E_OS_PROTECTION_ARRIVAL.
+ *   - Thời gian ISR chen vào được tính cho task đang chạy.
  * ========================================================= */
-void os_on_tick(void)
-{
-    /*nên nằm trong IncrementTick*/
-    OsCounter_t *c = &Counter_tbl[0];
-    s_tick++;
-    c->current_value = s_tick % c->max_allowed_Value;
+#if (OS_CFG_TIMING_PROT)
+typedef struct {
+    uint32_t budget_us;     /* 0 = không giới hạn */
+    uint32_t frame_us;      /* khoảng tối thiểu giữa 2 lần kích hoạt, 0 = không */
+} OsTimingCfg_t;
+
+static const OsTimingCfg_t tp_cfg[OS_MAX_TASKS] = {
+    [TASK_A] = { .budget_us = 1000u, .frame_us = 20000u },
+    [TASK_B] = { .budget_us = 5000u, .frame_us = 0u },
+    [TASK_C] = { .budget_us = 25000u, .frame_us = 0u },  /* busy_delay(20) chống dội ≈ 20 ms */
+};
 
-    /* Quét mọi alarm (ISR: atomic với thread) */
-    for (uint8_t i = 0u; i < OS_MAX_ALARMS; ++i)
-    {
-        OsAlarm_t *a = &alarm_tbl[i];
-        
-        if (!a->active)
-            continue;
+typedef struct {
+    uint32_t used;          /* chu kỳ đã dùng trong lần kích hoạt hiện tại */
+    uint32_t start;         /* CYCCNT lúc vào CPU */
+    uint32_t frame;         /* frame_us đổi ra chu kỳ */
+    uint32_t last_arrival;  /* CYCCNT lần kích hoạt được chấp nhận gần nhất */
+    uint8_t  arrived;
+    OsTaskTimingStats_t st;
+} OsTpRt_t;
 
-        if (a->remain_ms > 0u)
-        {
-            a->remain_ms--;
-        }
+static OsTpRt_t tp_rt[OS_MAX_TASKS];
+static uint32_t tp_cyc_per_us;
 
-        if (a->remain_ms == 0u)
-        {
-            switch(a->action_type){
-                case ALARMACTION_ACTIVATETASK:
-                    /* Kích hoạt task đích */
-                    ActivateTask(a->action.target_task);
-                    break;
-                case ALARMACTION_SETEVENT:
-                    SetEvent(a->action.Set_event.task_id, a->action.Set_event.mask);
-                    break;
-                case ALARMACTION_CALLBACK:
-                    a->action.callback();
-                    break;
-            }
-            /* Lặp hay one-shot */
-            if (a->cycle_ms > 0u) {
-                a->remain_ms = a->cycle_ms; /* nạp lại chu kỳ */
-            } else {
-                a->active = 0u; /* one-shot → tắt */
-            }   
-        }
-    }
-    ScheduleTable_tick(0);
-    /* Giảm latency: nếu chưa có pending switch và đang ở IDLE → chọn ngay */
-    if ((g_next == NULL) && (g_current == &tcb[TASK_IDLE])) {
-        (void)schedule();
-    }
+__attribute__((weak)) ProtectionReturnType ProtectionHook(StatusType fatal)
+{
+    (void)fatal;
+    return OS_CFG_TP_REACTION;
 }
 
-void ChainTask(TaskType id){
-    ActivateTask(id);
-    TerminateTask();
+static void tp_init(void)
+{
+    tp_cyc_per_us = SystemCoreClock / 1000000u;
+    for (uint8_t i = 0u; i < OS_MAX_TASKS; ++i) {
+        tp_rt[i].st.budget = tp_cfg[i].budget_us * tp_cyc_per_us;
+        tp_rt[i].frame     = tp_cfg[i].frame_us * tp_cyc_per_us;
+    }
+    os_port_tp_init();
 }
 
-void WaitEvent(EventMaskType mask){
-    // if(g_current == 0) return E_OS_STATE;
-    __disable_irq();
-    TCB_t *tc = &tcb[g_current->id];
-    //if(g_current->isExtend ==0) return E_OS_STATE;
-    if((tc -> SetEvent & mask)==0){
-        tc -> WaitEvent = mask;
-        tc -> state = OS_Waiting;
+/* Task vào CPU: đặt compare cho phần ngân sách còn lại */
+static void tp_begin(TCB_t *t)
+{
+    OsTpRt_t *r = &tp_rt[t->id];
+    r->start = os_perf_now();
+    if ((r->st.budget != 0u) && (r->used < r->st.budget)) {
+        os_port_tp_arm((r->st.budget - r->used) / tp_cyc_per_us);
     }
+}
 
-      if ((g_next == NULL) && (g_current == &tcb[TASK_IDLE])) {
-        (void)schedule();
+/* Task rời CPU; done = lần kích hoạt đã kết thúc (Terminate/Chain/bị huỷ) */
+static void tp_leave(TCB_t *t, bool done)
+{
+    OsTpRt_t *r = &tp_rt[t->id];
+    os_port_tp_disarm();
+    r->used += os_perf_now() - r->start;
+    if (done) {
+        r->st.exec_last = r->used;
+        if (r->used > r->st.exec_max)
+            r->st.exec_max = r->used;
+        r->used = 0u;
     }
-    
-    __enable_irq();
 }
 
- void SetEvent(TaskType id, EventMaskType mask){
-    TCB_t *tc = &tcb[id];
-    __disable_irq();
-    tc->SetEvent |= mask;
+void os_tp_switch(TCB_t *from, TCB_t *to)
+{
+    /* g_discard: ngữ cảnh bị bỏ → lần kích hoạt của 'from' đã xong */
+    tp_leave(from, from == g_discard);
+    tp_begin(to);
+}
+
+/* Gọi khi IRQ TẮT: true nếu lần kích hoạt này được chấp nhận */
+static bool tp_arrival_ok(TaskType tid)
+{
+    OsTpRt_t *r = &tp_rt[tid];
+    uint32_t now = os_perf_now();
+    if ((r->frame != 0u) && r->arrived && ((now - r->last_arrival) < r->frame)) {
+        r->st.arrivals++;
+        return false;
+    }
+    r->last_arrival = now;
+    r->arrived = 1u;
+    return true;
+}
+
+/* Kích hoạt bị từ chối (gọi khi IRQ MỞ) */
+static StatusType tp_arrival_violation(OSServiceIdType sid, TaskType tid)
+{
+    if (ProtectionHook(E_OS_PROTECTION_ARRIVAL) == PRO_SHUTDOWN)
+        ShutdownOS(E_OS_PROTECTION_ARRIVAL);
+    return OS_ERROR(sid, tid, E_OS_PROTECTION_ARRIVAL);
+}
+
+/* Huỷ task đang chạy từ ISR (như TerminateTask, PendSV bỏ ngữ cảnh) */
+static void tp_kill(TCB_t *t)
+{
+    if ((t->state != OS_RUNNING) || (t->id == TASK_IDLE))
+        return;                 /* đang rời CPU (WAITING...) hoặc IDLE */
+    task_end(t);
+}
+
+/* Compare TIM2: task đang chạy hết ngân sách (hoặc hết 1 đoạn 16 bit) */
+ISR2(TIM2_IRQHandler, ISR_TIMING)
+{
+    os_port_tp_disarm();
+    TCB_t *cur = (TCB_t *)g_current;
+    OsTpRt_t *r = &tp_rt[cur->id];
+    if (r->st.budget == 0u)
+        return;                 /* ngắt trễ của task trước rơi vào task không ngân sách */
+    uint32_t used = r->used + (os_perf_now() - r->start);
+    if (used < r->st.budget) {
+        os_port_tp_arm((r->st.budget - used) / tp_cyc_per_us);
+        return;                 /* ngân sách > 65 ms: nạp đoạn tiếp */
+    }
+
+    r->st.overruns++;
+    switch (ProtectionHook(E_OS_PROTECTION_TIME)) {
+        case PRO_TERMINATETASKISR:
+            __disable_irq();
+            tp_kill(cur);
+            __enable_irq();
+            break;
+        case PRO_SHUTDOWN:
+            ShutdownOS(E_OS_PROTECTION_TIME);
+            break;
+        default:
+            break;              /* PRO_IGNORE: chỉ đếm, không đặt lại compare */
+    }
+}
+
+StatusType GetTaskTiming(TaskType id, OsTaskTimingStats_t *out, uint8_t reset)
+{
+    OS_CHECK(id < OS_MAX_TASKS, OSServiceId_GetTaskTiming, id, E_OS_ID);
+    OS_CHECK(out != NULL, OSServiceId_GetTaskTiming, id, E_OS_VALUE);
+
+    __disable_irq();
+    OsTpRt_t *r = &tp_rt[id];
+    *out = r->st;
+    if (reset) {
+        r->st.exec_max = 0u;
+        r->st.overruns = 0u;
+        r->st.arrivals = 0u;
+    }
+    __enable_irq();
+    return E_OK;
+}
+#endif /* OS_CFG_TIMING_PROT */
+
+/* =========================================================
+ *  ActivateTask(): DORMANT → READY (không kích chồng)
+ *   - Task đang WAITING giữ nguyên ngữ cảnh (chỉ SetEvent/timeout đánh thức)
+ *   - task_activate(): thêm deadline tương đối (tick) của lần kích hoạt
+ *     (OS_DL_DEFAULT = bảng g_task_deadline) – dùng cho alarm/expiry point
+ * ========================================================= */
+static StatusType task_activate(TaskType tid, TickType rel_deadline)
+{
+    OS_CHECK(tid < OS_MAX_TASKS && tid != TASK_IDLE, OSServiceId_ActivateTask, tid, E_OS_ID);
+
+    __disable_irq();
+    TCB_t *t = &tcb[tid];
+    if (t->state != OS_DORMANT) {
+        __enable_irq();
+        return OS_ERROR(OSServiceId_ActivateTask, tid, E_OS_LIMIT);
+    }
+#if (OS_CFG_TIMING_PROT)
+    if (!tp_arrival_ok(tid)) {
+        __enable_irq();
+        return tp_arrival_violation(OSServiceId_ActivateTask, tid);
+    }
+#endif
+    /* *** Quan trọng: PSP về khung ban đầu để task chạy lại từ đầu entry.
+     *     Khung đã dựng sẵn → chỉ ghi lại R0/LR/PC/xPSR *** */
+    t->sp    = os_task_frame_rearm(g_task_frame[tid], g_task_entry[tid], g_task_arg[tid]);
+    t->state = OS_READY;
+#if (OS_CFG_EVENTS)
+    t->SetEvent = 0u;   /* OSEK: event bị xoá khi task được kích hoạt */
+#endif
+#if (OS_CFG_DEADLINE_MON)
+    t->deadline = s_tick + ((rel_deadline == OS_DL_DEFAULT) ? g_task_deadline[tid] : rel_deadline);
+#else
+    (void)rel_deadline;
+#endif
+    isr_mark_ready(t);
+    (void)rq_push_task(tid);
+
+    /* Fast-path: nếu đang Idle và chưa pending thì chuyển ngay */
+    os_dispatch();
+    __enable_irq();
+    return E_OK;
+}
+
+StatusType ActivateTask(TaskType tid)
+{
+    return task_activate(tid, OS_DL_DEFAULT);
+}
+
+/* =========================================================
+ *  TerminateTask(): Task tự kết thúc → DORMANT và chuyển lịch
+ * ========================================================= */
+StatusType TerminateTask(void)
+{
+    OS_CHECK(!os_in_isr(), OSServiceId_TerminateTask, 0u, E_OS_CALLEVEL);
+
+    __disable_irq();
+
+    TCB_t *cur = (TCB_t *)g_current;
+    if (cur)
+        task_end(cur);
+    else
+        (void)schedule();
+
+    __enable_irq();
+
+    /* Không quay lại thân task nữa */
+    for (;;)
+    {
+        __NOP();
+    }
+}
+
+/* =========================================================
+ *  Schedule(): điểm lập lịch do task tự gọi
+ *   - Chỉ đổi task khi có task READY được chạy trước task hiện tại;
+ *     task hiện tại về READY (giữ ngữ cảnh), chạy tiếp ngay sau đó.
+ *   - Nhóm resource nội: điểm duy nhất (ngoài WaitEvent/kết thúc) mà
+ *     task khác được chen vào → trong nhóm không cần khoá dữ liệu chung.
+ * ========================================================= */
+StatusType Schedule(void)
+{
+    OS_CHECK(!os_in_isr(), OSServiceId_Schedule, 0u, E_OS_CALLEVEL);
+
+    __disable_irq();
+    TCB_t *cur = (TCB_t *)g_current;
+    if ((g_next == NULL) && rq_yield(cur)) {
+        cur->state = OS_READY;
+        g_os_preempt++;
+        (void)schedule();
+    }
+    __enable_irq();     /* PendSV chạy ở đây; quay lại khi tới lượt */
+    return E_OK;
+}
+
+/* =========================================================
+ *  SetRelAlarm(aid, delay_ms, cycle_ms)
+ *   - Lưu runtime theo tick (ms → tick)
+ *   - Nếu đang active: ghi đè cấu hình mới
+ *   - Alarm chưa gắn counter (SetUpAlarm) → E_OS_NOFUNC
+ * ========================================================= */
+StatusType SetRelAlarm(uint8_t aid, uint32_t delay_ms, uint32_t cycle_ms)
+{
+    OS_CHECK(aid < OS_MAX_ALARMS, OSServiceId_SetRelAlarm, aid, E_OS_ID);
+
+    OsCounter_t *c = alarm_to_counter[aid];
+    if (c == NULL)
+        return OS_ERROR(OSServiceId_SetRelAlarm, aid, E_OS_NOFUNC);
+    uint32_t inc_ticks = ms_to_ticks(delay_ms == 0u ? 1u : delay_ms) % c->max_allowed_Value;
+    uint32_t cyc_ticks = ms_to_ticks(cycle_ms) % c->max_allowed_Value;
+    if ((cyc_ticks > 0u) && (cyc_ticks < 1u))
+    {
+        cyc_ticks = 1u; /* ép tối thiểu 1 tick nếu có chu kỳ */
+    }
+
+    __disable_irq();
     
-    if(tc->state == OS_Waiting && (tc->SetEvent & tc->WaitEvent)){
-        ActivateTask(tc ->id);
-        tc->WaitEvent = 0;
+    OsAlarm_t *a = &alarm_tbl[aid];
+    a->active = 1u;
+    a->expiry = s_tick + inc_ticks; /* mốc tuyệt đối */
+    a->cycle_ms = cyc_ticks;        /* LƯU THEO TICK */
+
+    __enable_irq();
+    return E_OK;
+}
+StatusType SetAbsAlarm(uint8_t aid, uint32_t delay_ms, uint32_t cycle_ms){
+    OS_CHECK(aid < OS_MAX_ALARMS, OSServiceId_SetAbsAlarm, aid, E_OS_ID);
+    OsCounter_t *c = alarm_to_counter[aid];
+    if (c == NULL)
+        return OS_ERROR(OSServiceId_SetAbsAlarm, aid, E_OS_NOFUNC);
+    uint32_t inc_ticks = ms_to_ticks(delay_ms == 0u ? 1u : delay_ms) % c->max_allowed_Value;
+    uint32_t cyc_ticks = ms_to_ticks(cycle_ms) % c->max_allowed_Value;
+    if ((cyc_ticks > 0u) && (cyc_ticks < 1u))
+    {
+        cyc_ticks = 1u; /* ép tối thiểu 1 tick nếu có chu kỳ */
     }
-    // nếu ở idle và chưa có next
-    if ((g_next == NULL) && (g_current == &tcb[TASK_IDLE])) {
+    __disable_irq();
+    OsAlarm_t *a = &alarm_tbl[aid];
+    /* delay_ms là giá trị TUYỆT ĐỐI của counter; đã qua → chờ vòng sau */
+    uint32_t delta = (inc_ticks + c->max_allowed_Value - c->current_value) % c->max_allowed_Value;
+    if (delta == 0u)
+        delta = c->max_allowed_Value;
+    a->active = 1u;
+    a->expiry = s_tick + delta;
+    a->cycle_ms = cyc_ticks;
+    __enable_irq();
+    return E_OK;
+}
+#if (OS_CFG_EVENTS)
+/* Hết thời gian chờ: gỡ task khỏi danh sách chờ rồi đánh thức
+ * (action của task_tmo[tid]) */
+static void task_timeout(uint8_t tid, uintptr_t arg, TickType dl)
+{
+    (void)arg;
+    (void)dl;
+    TCB_t *t = &tcb[tid];
+    if (t->state != OS_Waiting)
+        return;
+
+    if (t->wait_q != NULL) {
+        /* danh sách chờ nối đơn → tìm phần tử đứng trước */
+        TCB_t **pp = &t->wait_q->head;
+        while (*pp != NULL && *pp != t) {
+            pp = &(*pp)->next;
+        }
+        if (*pp == t) {
+            *pp = t->next;
+        }
+        t->next = NULL;
+    }
+    os_release_task(t, OS_WAIT_TIMEOUT);
+}
+#endif
+
+/* =========================================================
+ *  Action của Alarm / Expiry point (OsAction_t)
+ *   - Phân giải lúc cấu hình bằng OS_ACT_* → ISR tick chỉ gọi gián tiếp
+ *     fn(id, arg, dl), không rẽ nhánh theo loại action.
+ *   - Loại đã tắt (OS_CFG_ALARM_*) không có handler → cấu hình dùng nó
+ *     lỗi ngay lúc build.
+ * ========================================================= */
+static void act_activate(uint8_t id, uintptr_t arg, TickType dl)
+{
+    (void)arg;
+    (void)task_activate(id, dl);
+}
+
+#if (OS_CFG_ALARM_SETEVENT)
+static void act_setevent(uint8_t id, uintptr_t arg, TickType dl)
+{
+    (void)dl;
+    (void)SetEvent(id, (EventMaskType)arg);
+}
+#endif
+
+#if (OS_CFG_ALARM_CALLBACK)
+/* id = slot task timer: hoãn sang TASK_TIMER hoặc gọi ngay */
+static void act_callback(uint8_t id, uintptr_t arg, TickType dl)
+{
+    (void)dl;
+#if (OS_CFG_TIMER_TASK)
+    os_timer_defer(id, (void (*)(void))arg);
+#else
+    (void)id;
+    ((void (*)(void))arg)();
+#endif
+}
+#endif
+
+/* Khởi tạo action trong initializer của OsAlarm_t / Expiry_Point */
+#define OS_ACT_ACTIVATE(tid)        .act_id = (tid),  .action = { act_activate, 0u }
+#define OS_ACT_SETEVENT(tid, mask)  .act_id = (tid),  .action = { act_setevent, (mask) }
+#define OS_ACT_CALLBACK(slot, cb)   .act_id = (slot), .action = { act_callback, (uintptr_t)(cb) }
+#define OS_ACT_WAKEUP(tid)          .act_id = (tid),  .action = { task_timeout, 0u }
+
+/* Alarm lặp: deadline của task được kích = mốc kế tiếp */
+static inline void alarm_action(OsAlarm_t *a)
+{
+    a->action.fn(a->act_id, a->action.arg,
+                 (a->cycle_ms != 0u) ? (a->expiry - s_tick) : OS_DL_DEFAULT);
+}
+
+/* Kiểm tra 1 alarm tại thời điểm 'now'; đến hạn → action, nạp lại hoặc tắt.
+ *  - So sánh có dấu (now - expiry) → đúng cả khi s_tick tràn vòng.
+ *  - Lặp: mốc kế = mốc DANH NGHĨA + n*cycle (không tính từ 'now')
+ *    → ISR trễ / bù tick không làm chu kỳ trôi. */
+static void alarm_check(OsAlarm_t *a, TickType now)
+{
+    if (!a->active)
+        return;
+
+    uint32_t late = now - a->expiry;
+    if ((int32_t)late < 0)
+        return;                     /* chưa đến hạn */
+
+    a->late_last = late;
+    if (late > a->late_max)
+        a->late_max = late;
+
+    if (a->cycle_ms == 0u) {
+        a->active = 0u;             /* one-shot: tắt TRƯỚC action (callback có thể đặt lại) */
+        alarm_action(a);
+        return;
+    }
+
+    /* Số mốc đã qua tính đến 'now' (kể cả mốc đang xét) */
+    uint32_t n = late / a->cycle_ms + 1u;
+    a->expiry += n * a->cycle_ms;
+
+    switch (a->catchup) {
+        case ALARM_CATCHUP_ALL:
+            while (n--) {
+                alarm_action(a);
+            }
+            break;
+        case ALARM_CATCHUP_ONCE:
+            a->missed += n - 1u;
+            alarm_action(a);
+            break;
+        case ALARM_CATCHUP_SKIP:
+            if (n > 1u) {
+                a->missed += n;     /* đã lỡ ≥ 1 chu kỳ → bỏ cả loạt */
+            } else {
+                alarm_action(a);
+            }
+            break;
+    }
+}
+
+/* Đọc thống kê alarm (thread context) */
+StatusType GetAlarmStats(uint8_t aid, OsAlarmStats_t *out, uint8_t reset)
+{
+    OS_CHECK(aid < OS_MAX_ALARMS, OSServiceId_GetAlarmStats, aid, E_OS_ID);
+    OS_CHECK(out != NULL, OSServiceId_GetAlarmStats, aid, E_OS_VALUE);
+
+    __disable_irq();
+    OsAlarm_t *a = &alarm_tbl[aid];
+    out->late_last = a->late_last;
+    out->late_max  = a->late_max;
+    out->missed    = a->missed;
+    if (reset) {
+        a->late_max = 0u;
+        a->missed   = 0u;
+    }
+    __enable_irq();
+    return E_OK;
+}
+
+#if (OS_CFG_RR)
+/* =========================================================
+ *  Round-robin giữa các task cùng ưu tiên (OS_CFG_RR)
+ *   - g_rr_slice[prio]: số tick mỗi lượt; 0 = không cắt lượt. Mức
+ *     time-critical để 0 → mỗi tick chỉ tốn 1 lần đọc bảng.
+ *   - Task giữ resource nội (ires_members) không bao giờ bị cắt lượt.
+ *   - Lượt tính từ tick đầu tiên task giữ CPU (rr_owner đổi → nạp lại).
+ *   - Hết lượt + có task cùng mức đang READY (rq_prio_n, O(1)): current
+ *     về cuối mức ưu tiên của nó (rq_rotate), giữ nguyên ngữ cảnh – PendSV
+ *     lưu như đổi task thường. Không có task cùng mức → nạp lượt mới.
+ *     Bảng đếm chỉ có khi bật OS_CFG_RR.
+ * ========================================================= */
+static const uint8_t g_rr_slice[OS_PRIO_URGENT + 1u] = {
+    [2u] = 10u,     /* TASK_B / C / D: log, thăm dò nút, chẩn đoán nền */
+};
+
+static TCB_t  *rr_owner = NULL;
+static uint8_t rr_left  = 0u;
+
+static void rr_tick(TickType n)
+{
+    TCB_t *cur = (TCB_t *)g_current;
+    if ((cur == NULL) || (cur->prio > OS_PRIO_URGENT) || (ires_tasks & (1u << cur->id)))
+        return;
+    uint8_t slice = g_rr_slice[cur->prio];
+    if (slice == 0u)
+        return;
+
+    if (cur != rr_owner) {
+        rr_owner = cur;
+        rr_left  = slice;
+    }
+    if (rr_left > n) {
+        rr_left = (uint8_t)(rr_left - n);
+        return;
+    }
+    rr_left = slice;
+
+    __disable_irq();
+    if ((g_next == NULL) && (cur->state == OS_RUNNING) && (rq_prio_n[cur->prio] != 0u)) {
+        cur->state = OS_READY;
+        rq_rotate(cur);
+        rr_owner = NULL;
+        g_os_preempt++;
         (void)schedule();
     }
     __enable_irq();
+}
+#endif
 
+#if (OS_CFG_TIMER_TASK)
+/* =========================================================
+ *  TASK_TIMER vừa READY trong tick → đẩy task đang chạy ra như
+ *  Schedule() (cur xếp ngay sau timer), PendSV chuyển sang timer khi
+ *  thoát ISR tick. Task bị đẩy chạy tiếp ngay khi timer chờ lại →
+ *  trình tự như callback chạy trong ISR, chỉ ISR không phải chờ nó.
+ * ========================================================= */
+static void timer_preempt(void)
+{
+    TCB_t *cur = (TCB_t *)g_current;
+    if ((cur == NULL) || (cur == &tcb[TASK_TIMER]) || (cur == &tcb[TASK_IDLE]))
+        return;
+
+    __disable_irq();
+    if ((g_next == NULL) && (cur->state == OS_RUNNING) &&
+        (tcb[TASK_TIMER].state == OS_READY) && rq_yield(cur)) {
+        cur->state = OS_READY;
+        g_os_preempt++;
+        (void)schedule();
+    }
+    __enable_irq();
 }
-EventMaskType GetEvent(TaskType id, EventMaskType *event){
+#endif
+
+/* =========================================================
+ *  os_on_ticks(n): tiến counter hệ thống n tick – CHỈ gọi trong ISR,
+ *  IRQ đang MỞ: các đường lồng bên trong (task_activate, rr_tick,
+ *  timer_preempt...) tự tắt/mở IRQ, không khôi phục PRIMASK của caller
+ *   - Tăng tick, quét Alarm → action khi đến hạn (theo catch-up)
+ *   - Quét timer chờ của task (WaitEvent/MsgQ có timeout)
+ *   - Run-to-completion: chỉ schedule ngay khi current là IDLE
+ *     (ngoại lệ: hết lượt round-robin, OS_CFG_RR; callback hoãn sang
+ *     TASK_TIMER, OS_CFG_TIMER_TASK)
+ * ========================================================= */
+void os_on_ticks(TickType n)
+{
+    /*nên nằm trong IncrementTick*/
+    OsCounter_t *c = &Counter_tbl[0];
+    s_tick += n;
+    c->current_value = s_tick % c->max_allowed_Value;
+
+    TickType now = s_tick;
+    /* Quét mọi alarm (ISR: atomic với thread) */
+    for (uint8_t i = 0u; i < OS_MAX_ALARMS; ++i)
+    {
+        alarm_check(&alarm_tbl[i], now);
+    }
+#if (OS_CFG_EVENTS)
+    for (uint8_t i = 0u; i < OS_MAX_TASKS; ++i)
+    {
+        alarm_check(&task_tmo[i], now);
+    }
+#endif
+#if (OS_CFG_SCHTBL)
+    ScheduleTable_tick(0);
+#endif
+#if (OS_CFG_RR)
+    rr_tick(n);
+#endif
+#if (OS_CFG_TIMER_TASK)
+    timer_preempt();
+#endif
+    /* Giảm latency: nếu chưa có pending switch và đang ở IDLE → chọn ngay */
+    os_dispatch();
+}
+
+#ifdef APP_BENCH
+OsPerf_t g_os_tick_perf;
+volatile uint32_t g_os_tick_t0;
+#endif
+
+/* os_on_tick(): gọi mỗi nhịp SysTick (ISR context) */
+void os_on_tick(void)
+{
+#ifdef APP_BENCH
+    uint32_t t0 = os_perf_now();
+    g_os_tick_t0 = t0;
+#endif
+    OsIsrFrame_t f;
+    os_isr_enter(&f, ISR_SYSTICK);
+    os_on_ticks(1u);
+    os_isr_exit(&f);
+#ifdef APP_BENCH
+    os_perf_add(&g_os_tick_perf, os_perf_now() - t0);
+#endif
+}
+
+/* =========================================================
+ *  ChainTask(): kết thúc task hiện tại + Activate id trong 1 vùng tới hạn
+ *   - Target ưu tiên cao hơn mọi task đang READY (và chưa có vé) →
+ *     đặt vé thẳng cho target, không đi qua READY queue (1 lần PendSV).
+ *   - Ngược lại: vào READY queue như ActivateTask rồi schedule().
+ *   - ChainTask(chính nó): không thể dựng khung khi còn đang chạy trên
+ *     stack đó → chạy lại ngay tại chỗ (os_task_restart), hoặc nếu phải
+ *     xếp hàng thì sp = NULL và schedule() dựng khung khi dispatch.
+ * ========================================================= */
+StatusType ChainTask(TaskType id){
+    OS_CHECK(id < OS_MAX_TASKS && id != TASK_IDLE, OSServiceId_ChainTask, id, E_OS_ID);
+    OS_CHECK(!os_in_isr(), OSServiceId_ChainTask, id, E_OS_CALLEVEL);
+
+    __disable_irq();
+    TCB_t *cur = (TCB_t *)g_current;
+    TCB_t *t   = &tcb[id];
+    if ((t != cur) && (t->state != OS_DORMANT)) {
+        __enable_irq();     /* không kích chồng: caller KHÔNG kết thúc */
+        return OS_ERROR(OSServiceId_ChainTask, id, E_OS_LIMIT);
+    }
+#if (OS_CFG_TIMING_PROT)
+    if (!tp_arrival_ok(id)) {
+        __enable_irq();
+        return tp_arrival_violation(OSServiceId_ChainTask, id);
+    }
+#endif
+#if (OS_CFG_DEADLINE_MON)
+    if (t == cur)
+        dl_finish(cur);
+    t->deadline = s_tick + g_task_deadline[id];
+#endif
+    bool direct = (g_next == NULL) && rq_outranked_by(t);
+
+    if (t == cur) {
+#if (OS_CFG_EVENTS)
+        t->SetEvent = 0u;
+#endif
+        if (direct) {
+            /* không qua PendSV → tự gọi hook như một lần đổi task */
+            OS_HOOK(PostTaskHook);
+#if (OS_CFG_TIMING_PROT)
+            tp_leave(cur, true);
+            tp_begin(cur);
+#endif
+            OS_HOOK(PreTaskHook);
+            os_task_restart(g_task_frame[id], g_task_entry[id], g_task_arg[id]);
+        }
+        t->sp     = NULL;       /* schedule() dựng khung khi dispatch */
+        t->state  = OS_READY;
+        g_discard = cur;
+        (void)rq_push(id);      /* sau task vượt nó (direct = false) → không bị pop ngay */
+        (void)schedule();
+    } else {
+#if (OS_CFG_DEADLINE_MON)
+        dl_finish(cur);
+#endif
+        cur->state = OS_DORMANT;
+        g_discard  = cur;       /* như TerminateTask: không lưu ngữ cảnh */
+
+        t->sp       = os_task_frame_rearm(g_task_frame[id], g_task_entry[id], g_task_arg[id]);
+#if (OS_CFG_EVENTS)
+        t->SetEvent = 0u;
+#endif
+        if (direct) {
+            t->state = OS_RUNNING;
+            g_next   = t;       /* hand-off trực tiếp */
+            os_trigger_pendsv();
+        } else {
+            t->state = OS_READY;
+            isr_mark_ready(t);
+            (void)rq_push_task(id);
+            (void)schedule();
+        }
+    }
+    __enable_irq();
+
+    /* Không quay lại thân task nữa */
+    for (;;)
+    {
+        __NOP();
+    }
+}
+
+/* =========================================================
+ *  Chờ/đánh thức (dùng chung cho WaitEvent và os_msgq.c)
+ *   - WAITING giữ nguyên ngữ cảnh: PendSV lưu R4..R11, khi được đánh
+ *     thức task chạy tiếp ngay sau os_wait_current() (KHÔNG dựng lại stack).
+ * ========================================================= */
+bool os_in_isr(void)
+{
+    return (__get_IPSR() != 0u);
+}
+
+TickType os_tick_now(void)
+{
+    return s_tick;
+}
+
+#if (OS_CFG_EVENTS)
+void os_waitq_insert(OsWaitQ_t *q, TCB_t *t)
+{
+    TCB_t **pp = &q->head;
+    while (*pp != NULL && (*pp)->prio >= t->prio) {
+        pp = &(*pp)->next;
+    }
+    t->next = *pp;
+    *pp = t;
+}
+
+TCB_t *os_waitq_pop(OsWaitQ_t *q)
+{
+    TCB_t *t = q->head;
+    if (t != NULL) {
+        q->head = t->next;
+        t->next = NULL;
+    }
+    return t;
+}
+
+uint8_t os_wait_current(OsWaitQ_t *q, void *data, TickType timeout)
+{
+    TCB_t *cur = (TCB_t *)g_current;
+
+    cur->state     = OS_Waiting;
+    cur->wait_rc   = OS_WAIT_OK;
+    cur->wait_q    = q;
+    cur->wait_data = data;
+    if (q != NULL) {
+        os_waitq_insert(q, cur);
+    }
+    if (timeout != OS_WAIT_FOREVER) {
+        OsAlarm_t *a = &task_tmo[cur->id];
+        a->expiry    = s_tick + ((timeout == 0u) ? 1u : timeout);
+        a->cycle_ms  = 0u;
+        a->active    = 1u;
+    }
+
+    (void)schedule();
+    /* Mở IRQ → PendSV được nhận ngay và đổi sang task khác.
+     * Khi được đánh thức, task chạy tiếp tại đây (state đã là RUNNING). */
+    do {
+        __enable_irq();
+        __disable_irq();
+    } while (cur->state == OS_Waiting);
+
+    return cur->wait_rc;
+}
+
+/* WAITING → READY, KHÔNG ra quyết định lập lịch (caller tự làm 1 lần).
+ * TASK_TIMER/TASK_PT (dl_restamp_tasks): deadline tính lại từ lúc thức,
+ * không giữ mốc cũ tới khi dl_before tràn */
+static void task_wake(TCB_t *t, uint8_t rc)
+{
+    task_tmo[t->id].active = 0u;   /* huỷ timer chờ (nếu có) */
+    t->wait_rc   = rc;
+    t->wait_q    = NULL;
+    t->WaitEvent = 0u;
+    t->state     = OS_READY;
+#if (OS_CFG_DEADLINE_MON)
+    if (dl_restamp_tasks & (1u << t->id))
+        t->deadline = s_tick + g_task_deadline[t->id];
+#endif
+    isr_mark_ready(t);
+    (void)rq_push_task(t->id);
+}
+
+void os_release_task(TCB_t *t, uint8_t rc)
+{
+    if (t->state != OS_Waiting)
+        return;
+
+    task_wake(t, rc);
+
+    /* Đang ở IDLE (đánh thức từ ISR) → chuyển ngay */
+    os_dispatch();
+}
+
+/* =========================================================
+ *  WaitEvent(): chặn task hiện tại tới khi có 1 event trong mask
+ * ========================================================= */
+StatusType WaitEvent(EventMaskType mask){
+    OS_CHECK(!os_in_isr(), OSServiceId_WaitEvent, mask, E_OS_CALLEVEL);
+
+    __disable_irq();
+    TCB_t *tc = (TCB_t *)g_current;
+    if((tc -> SetEvent & mask)==0){
+        tc -> WaitEvent = mask;
+        (void)os_wait_current(NULL, NULL, OS_WAIT_FOREVER);
+    }
+    __enable_irq();
+    return E_OK;
+}
+
+/* =========================================================
+ *  WaitEventTimeout(): như WaitEvent, thêm giới hạn thời gian
+ *   - Dùng timer chờ của task (task_tmo) trên counter hệ thống
+ *   - Hết giờ → set OS_EVENT_TIMEOUT; ticks = 0 → hết giờ ngay
+ * ========================================================= */
+StatusType WaitEventTimeout(EventMaskType mask, TickType ticks){
+    OS_CHECK(!os_in_isr(), OSServiceId_WaitEvent, mask, E_OS_CALLEVEL);
+
+    __disable_irq();
+    TCB_t *tc = (TCB_t *)g_current;
+    if((tc -> SetEvent & mask)==0){
+        uint8_t rc = OS_WAIT_TIMEOUT;
+        if (ticks != 0u) {
+            tc -> WaitEvent = mask;
+            rc = os_wait_current(NULL, NULL, ticks);
+        }
+        if (rc == OS_WAIT_TIMEOUT) {
+            tc -> SetEvent |= OS_EVENT_TIMEOUT;
+        }
+    }
+    __enable_irq();
+    return E_OK;
+}
+
+/* Gọi khi IRQ tắt: set event, đánh thức nếu đang chờ event đó */
+static void event_set(TCB_t *tc, EventMaskType mask)
+{
+    tc->SetEvent |= mask;
+
+    if(tc->state == OS_Waiting && tc->wait_q == NULL && (tc->SetEvent & tc->WaitEvent)){
+        task_wake(tc, OS_WAIT_OK);
+    }
+    // nếu ở idle và chưa có next
+    os_dispatch();
+}
+
+StatusType SetEvent(TaskType id, EventMaskType mask){
+    OS_CHECK(id < OS_MAX_TASKS, OSServiceId_SetEvent, id, E_OS_ID);
+    TCB_t *tc = &tcb[id];
+    __disable_irq();
+#if (OS_STATUS_EXTENDED)
+    if (tc->state == OS_DORMANT) {
+        __enable_irq();
+        return OS_ERROR(OSServiceId_SetEvent, id, E_OS_STATE);
+    }
+#endif
+    event_set(tc, mask);
+    __enable_irq();
+    return E_OK;
+}
+
+void os_notify_event(TaskType id, EventMaskType mask)
+{
+    TCB_t *tc = &tcb[id];
+    __disable_irq();
+    if (tc->state != OS_DORMANT)
+        event_set(tc, mask);
+    __enable_irq();
+}
+
+/* =========================================================
+ *  SetEventGroup(): set event cho mọi task trong nhóm
+ *   - 1 vùng tới hạn cho cả nhóm, đánh thức các task đang chờ,
+ *     chỉ 1 quyết định lập lịch ở cuối (thay vì N lần SetEvent)
+ * ========================================================= */
+StatusType SetEventGroup(uint8_t gid, EventMaskType mask){
+    OS_CHECK(gid < OS_MAX_TASKGROUP, OSServiceId_SetEventGroup, gid, E_OS_ID);
+
+    uint32_t members = task_group[gid];
+    __disable_irq();
+    while (members != 0u) {
+        uint8_t id = (uint8_t)(31u - __CLZ(members));
+        members &= ~(1u << id);
+
+        TCB_t *tc = &tcb[id];
+        tc->SetEvent |= mask;
+        if(tc->state == OS_Waiting && tc->wait_q == NULL && (tc->SetEvent & tc->WaitEvent)){
+            task_wake(tc, OS_WAIT_OK);
+        }
+    }
+    os_dispatch();
+    __enable_irq();
+    return E_OK;
+}
+StatusType GetEvent(TaskType id, EventMaskType *event){
+    OS_CHECK(id < OS_MAX_TASKS, OSServiceId_GetEvent, id, E_OS_ID);
+    OS_CHECK(tcb[id].state != OS_DORMANT, OSServiceId_GetEvent, id, E_OS_STATE);
     *event = tcb[id].SetEvent;
+    return E_OK;
 }
 
-void ClearEvent(EventMaskType mask){
-    TCB_t *t = &tcb[g_current->id];
+StatusType ClearEvent(EventMaskType mask){
+    OS_CHECK(!os_in_isr(), OSServiceId_ClearEvent, mask, E_OS_CALLEVEL);
+    TCB_t *t = (TCB_t *)g_current;
+    __disable_irq();
     t->SetEvent &= ~ mask;
+    __enable_irq();
+    return E_OK;
 }
+#endif /* OS_CFG_EVENTS */
+
+/* =========================================================
+ *  GetTaskID(): ID task đang chạy
+ * ========================================================= */
+StatusType GetTaskID(TaskRefType id){
+    *id = g_current->id;
+    return E_OK;
+}
+
+#if (OS_CFG_DEADLINE_MON)
+/* =========================================================
+ *  GetDeadlineMisses(): số lần kích hoạt kết thúc quá deadline
+ * ========================================================= */
+StatusType GetDeadlineMisses(TaskType id, uint32_t *misses, uint8_t reset)
+{
+    OS_CHECK(id < OS_MAX_TASKS, OSServiceId_GetDeadlineMisses, id, E_OS_ID);
+    OS_CHECK(misses != NULL, OSServiceId_GetDeadlineMisses, id, E_OS_VALUE);
+
+    __disable_irq();
+    *misses = dl_miss[id];
+    if (reset)
+        dl_miss[id] = 0u;
+    __enable_irq();
+    return E_OK;
+}
+#endif
+
+/* =========================================================
+ *  GetTaskState(): đọc trạng thái (OsTaskState_e) của task
+ * ========================================================= */
+StatusType GetTaskState(TaskType id, TaskStateRefType state){
+    OS_CHECK(id < OS_MAX_TASKS, OSServiceId_GetTaskState, id, E_OS_ID);
+    *state = tcb[id].state;
+    return E_OK;
+}
+#if (OS_CFG_SCHTBL)
 /*      API cho Schedule Table       */
-void StartSchedulTblRel(uint8_t sid, TickType offset){
+static inline void sch_sync_reset(OsSchedTbl *s)
+{
+    s->deviation = 0;
+    s->sync_on = 0u;
+}
+
+StatusType StartSchedulTblRel(uint8_t sid, TickType offset){
 
-    if(sid >= OS_MAX_SchedTbl) return;
+    OS_CHECK(sid < OS_MAX_SchedTbl, OSServiceId_StartScheduleTable, sid, E_OS_ID);
     OsSchedTbl *s = &Schedule_Table_List[sid];
-    if(s->state != ST_STOP)  return;
-    if(offset >= s->counter->max_allowed_Value) return;
+    OS_CHECK(offset < s->counter->max_allowed_Value, OSServiceId_StartScheduleTable, sid, E_OS_VALUE);
+    if(s->state != ST_STOP)
+        return OS_ERROR(OSServiceId_StartScheduleTable, sid, E_OS_STATE);
 
     s->start = (s->counter->current_value + offset) % s->counter->max_allowed_Value;
     s->current_ep =0;
+    sch_sync_reset(s);
     s->state = ST_WAITING_START;
+    return E_OK;
 }
 
+StatusType StartSchedulTblAbs(uint8_t sid, TickType start){
 
-void StopSchedulTbl(uint8_t sid){
-    if(sid >= OS_MAX_SchedTbl) return;
+    OS_CHECK(sid < OS_MAX_SchedTbl, OSServiceId_StartScheduleTable, sid, E_OS_ID);
     OsSchedTbl *s = &Schedule_Table_List[sid];
-    if(s->state == ST_STOP)  return;
+    OS_CHECK(start < s->counter->max_allowed_Value, OSServiceId_StartScheduleTable, sid, E_OS_VALUE);
+    if(s->state != ST_STOP)
+        return OS_ERROR(OSServiceId_StartScheduleTable, sid, E_OS_STATE);
 
+    s->start = start;
+    s->current_ep =0;
+    sch_sync_reset(s);
+    s->state = ST_WAITING_START;
+    return E_OK;
+}
+
+
+StatusType StopSchedulTbl(uint8_t sid){
+    OS_CHECK(sid < OS_MAX_SchedTbl, OSServiceId_StopScheduleTable, sid, E_OS_ID);
+    OsSchedTbl *s = &Schedule_Table_List[sid];
+
+    __disable_irq();
+    if(s->state == ST_STOP){
+        __enable_irq();
+        return OS_ERROR(OSServiceId_StopScheduleTable, sid, E_OS_NOFUNC);
+    }
+    if(s->state == ST_NEXT){
+        /* huỷ bàn giao đang chờ: gỡ khỏi bảng trước */
+        for(uint8_t i = 0u; i < OS_MAX_SchedTbl; i++){
+            if(Schedule_Table_List[i].next == sid)
+                Schedule_Table_List[i].next = OS_SCHTBL_NONE;
+        }
+    } else if(s->next != OS_SCHTBL_NONE){
+        Schedule_Table_List[s->next].state = ST_STOP;   /* bảng kế dừng theo */
+    }
+    s->next = OS_SCHTBL_NONE;
     s->state = ST_STOP;
     s->current_ep =0;
+    sch_sync_reset(s);
+    __enable_irq();
+    return E_OK;
 }
 
-void SyncSchedulTbl(uint8_t sid, TickType new_offset){
-    if(sid >= OS_MAX_SchedTbl) return ;
+/* =========================================================
+ *  NextSchedulTbl(): nối bảng 'to' sau bảng 'from'
+ *   - Bàn giao trong ISR tick: 'to' lấy start = điểm kết thúc chu kỳ
+ *     của 'from' → cả bộ kích hoạt đổi nguyên khối ở 1 tick xác định,
+ *     không có chu kỳ lai, không hụt/thừa tick.
+ *   - 'from' đã có bảng kế: bảng kế cũ về STOP, 'to' thay thế.
+ *   - to == from: huỷ bàn giao đang chờ; 'to' đã là bảng kế: giữ nguyên.
+ *     Kiểm trạng thái + huỷ/thay trong CÙNG vùng khoá với ISR tick →
+ *     không có khe để bàn giao xen giữa (E_OS_NOFUNC: đã bàn giao).
+ * ========================================================= */
+StatusType NextSchedulTbl(uint8_t from, uint8_t to){
+    OS_CHECK(from < OS_MAX_SchedTbl && to < OS_MAX_SchedTbl, OSServiceId_NextScheduleTable, from, E_OS_ID);
+    OsSchedTbl *f = &Schedule_Table_List[from];
+    OsSchedTbl *t = &Schedule_Table_List[to];
+    OS_CHECK(f->counter == t->counter, OSServiceId_NextScheduleTable, to, E_OS_ID);
+
+    __disable_irq();
+    if(f->state == ST_STOP || f->state == ST_NEXT){
+        __enable_irq();
+        return OS_ERROR(OSServiceId_NextScheduleTable, from, E_OS_NOFUNC);
+    }
+    if(to == from || f->next == to){
+        if(to == from && f->next != OS_SCHTBL_NONE){
+            Schedule_Table_List[f->next].state = ST_STOP;
+            f->next = OS_SCHTBL_NONE;
+        }
+        __enable_irq();
+        return E_OK;
+    }
+    if(t->state != ST_STOP){
+        __enable_irq();
+        return OS_ERROR(OSServiceId_NextScheduleTable, to, E_OS_STATE);
+    }
+    if(f->next != OS_SCHTBL_NONE)
+        Schedule_Table_List[f->next].state = ST_STOP;
+    f->next = to;
+    t->current_ep = 0;
+    sch_sync_reset(t);
+    t->state = ST_NEXT;
+    __enable_irq();
+    return E_OK;
+}
+
+/* =========================================================
+ *  SyncSchedulTbl(): đồng bộ tường minh (kiểu AUTOSAR)
+ *   - Bảng đang chạy: chỉ ghi độ lệch (đưa về (-duration/2, duration/2]);
+ *     việc bù nằm ở sch_adjust() sau mỗi expiry point → không EP nào
+ *     bị bỏ hay chạy 2 lần, không có cú nhảy pha.
+ *   - Bảng chưa chạy (WAITING): bắt đầu ngay tại vị trí value, các EP
+ *     có offset < value của chu kỳ đầu bị bỏ qua.
+ * ========================================================= */
+StatusType SyncSchedulTbl(uint8_t sid, TickType value){
+    OS_CHECK(sid < OS_MAX_SchedTbl, OSServiceId_SyncScheduleTable, sid, E_OS_ID);
     OsSchedTbl *s = &Schedule_Table_List[sid];
-    if(s->state == ST_STOP) return
+    OS_CHECK(value < s->duration, OSServiceId_SyncScheduleTable, sid, E_OS_VALUE);
+
+    __disable_irq();
+    if(s->state == ST_STOP || s->state == ST_NEXT){
+        __enable_irq();
+        return OS_ERROR(OSServiceId_SyncScheduleTable, sid, E_OS_STATE);
+    }
+
+    TickType max = s->counter->max_allowed_Value;
+    TickType cur = s->counter->current_value;
+    if(s->state == ST_RUNNING){
+        int32_t dev  = (int32_t)diff_wrap(cur, s->start, max) - (int32_t)value;
+        int32_t half = (int32_t)(s->duration / 2u);
+        if(dev > half)
+            dev -= (int32_t)s->duration;
+        else if(dev <= -half)
+            dev += (int32_t)s->duration;
+        s->deviation = dev;
+    } else {
+        s->start = (cur + max - value) % max;
+        s->current_ep = 0;
+        while(s->current_ep < s->num_eps && s->eps[s->current_ep].offset < value)
+            s->current_ep++;
+        s->deviation = 0;
+        s->state = ST_RUNNING;
+    }
+    s->sync_on = 1u;
+    __enable_irq();
+    return E_OK;
+}
+
+StatusType GetSchedulTblStatus(uint8_t sid, ScheduleTableStatusRefType status){
+    OS_CHECK(sid < OS_MAX_SchedTbl, OSServiceId_GetScheduleTableStatus, sid, E_OS_ID);
+    const OsSchedTbl *s = &Schedule_Table_List[sid];
+
+    if(s->state == ST_STOP){
+        *status = SCHEDULETABLE_STOPPED;
+    } else if(s->state == ST_NEXT){
+        *status = SCHEDULETABLE_NEXT;
+    } else if(s->state == ST_WAITING_START){
+        *status = SCHEDULETABLE_WAITING;
+    } else {
+        int32_t dev = s->deviation;
+        TickType mag = (TickType)((dev < 0) ? -dev : dev);
+        *status = (s->sync_on && mag <= s->precision) ? SCHEDULETABLE_RUNNING_AND_SYNCHRONOUS
+                                                       : SCHEDULETABLE_RUNNING;
+    }
+    return E_OK;
+}
+
+/* Deadline tương đối của task kích bởi expiry point ep: tới expiry
+ * point kế tiếp (ep cuối: tới hết chu kỳ bảng), theo tick của counter */
+static inline TickType sch_ep_gap(const OsSchedTbl *s, uint8_t ep)
+{
+    TickType next = (ep + 1u < s->num_eps) ? s->eps[ep + 1u].offset : s->duration;
+    return next - s->eps[ep].offset;
+}
+
+/* Bù độ lệch trên khoảng sau expiry point ep (vừa chạy, vị trí e):
+ *  - bảng đi trước: kéo dài (start lùi), tối đa max_retard và không lùi
+ *    quá đầu chu kỳ
+ *  - bảng đi sau: rút ngắn (start tiến), tối đa max_advance và vẫn còn
+ *    ≥ 1 tick tới EP kế / hết chu kỳ → EP kế không bị nuốt
+ * Trả về vị trí mới trong chu kỳ. */
+static TickType sch_adjust(OsSchedTbl *s, const Expiry_Point *ep, TickType e, TickType max)
+{
+    if(s->deviation > 0){
+        TickType r = (TickType)s->deviation;
+        if(r > ep->max_retard) r = ep->max_retard;
+        if(r > e)              r = e;
+        s->start = (s->start + r) % max;
+        s->deviation -= (int32_t)r;
+        return e - r;
+    }
+    if(s->deviation < 0){
+        TickType next = (s->current_ep < s->num_eps) ? s->eps[s->current_ep].offset : s->duration;
+        TickType a = (TickType)(-s->deviation);
+        if(a > ep->max_advance) a = ep->max_advance;
+        if(e + a + 1u > next)   a = (next > e + 1u) ? (next - e - 1u) : 0u;
+        s->start = (s->start + max - a) % max;
+        s->deviation += (int32_t)a;
+        return e + a;
+    }
+    return e;
+}
 
-    s->start = (s->counter->current_value + new_offset) % s->counter->max_allowed_Value;
+/* Chạy expiry point hiện tại, sang EP kế và bù lệch (nếu có) */
+static TickType sch_expire(OsSchedTbl *s, TickType e, TickType max)
+{
+    Expiry_Point *ep = &s->eps[s->current_ep];
+    ep->action.fn(ep->act_id, ep->action.arg, sch_ep_gap(s, s->current_ep));
+    s->current_ep++;
+    return sch_adjust(s, ep, e, max);
+}
+
+/* Hết chu kỳ của s và có bảng kế: bảng kế bắt đầu tại điểm kết thúc
+ * chu kỳ của s và chạy luôn các EP đến hạn trong tick này; s dừng */
+static void sch_handover(OsSchedTbl *s, TickType cur, TickType max)
+{
+    OsSchedTbl *n = &Schedule_Table_List[s->next];
+
+    n->start = (s->start + s->duration) % max;
+    n->current_ep = 0;
+    n->state = ST_RUNNING;
+
+    s->next = OS_SCHTBL_NONE;
+    s->state = ST_STOP;
     s->current_ep = 0;
-    s->state = ST_WAITING_START;
+    sch_sync_reset(s);
+
+    TickType e = diff_wrap(cur, n->start, max);
+    while(n->current_ep < n->num_eps && n->eps[n->current_ep].offset <= e)
+        e = sch_expire(n, e, max);
 }
 
+/* Quét các bảng gắn với counter cid (gọi mỗi tick)
+ *  - WAITING: vị trí (cur - start) < duration → bắt đầu chạy; còn lại
+ *    là mốc bắt đầu ở tương lai → chờ tiếp.
+ *  - Hết chu kỳ: có bảng kế → bàn giao; bảng lặp dời start theo bội
+ *    duration (bù cả chu kỳ bị lỡ) và chạy luôn các EP đến hạn của chu
+ *    kỳ mới. */
 void ScheduleTable_tick(CounterType cid){
     OsCounter_t *c = &Counter_tbl[cid];
 
-    for(int i=0;i < OS_MAX_SchedTbl; i++){
-        OsSchedTbl *s = &Schedule_Table_List[cid];
-        
-        if( s-> counter != c || s-> state == ST_STOP) continue;
+    for(uint8_t i = 0u; i < OS_MAX_SchedTbl; i++){
+        OsSchedTbl *s = &Schedule_Table_List[i];
+
+        if( s-> counter != c || s-> state == ST_STOP || s->state == ST_NEXT) continue;
         TickType cur = c->current_value;
         TickType max = c->max_allowed_Value;
-        TickType elapsed_from_start = diff_wrap(cur, s->start, max);
-
-        if(s -> state == ST_WAITING_START){
-            if(elapsed_from_start < s->duration){
-                s->state = ST_RUNNING;
-                s->current_ep = 0;
-
-                while(s->current_ep < s->num_eps && s->eps[s->current_ep].offset <= elapsed_from_start){
-                    Expiry_Point *ep = &s->eps[s->current_ep];
-                    switch(ep->action_type){
-                        case SCH_ACTIVATE_TASK:
-                            ActivateTask(ep->action.tid);
-                            break;
-                        case SCH_SET_EVENT:
-                            SetEvent(ep->action.Set_event.tid,ep->action.Set_event.mask);
-                            break;
-                        case SCH_CALLBACK:
-                            ep->action.callback_fn();
-                            break;
-                    }
-                    s->current_ep++;
-                }
+        TickType e = diff_wrap(cur, s->start, max);
 
-            } else {
-                if(s->cyclic){
-                    TickType periods_skipped = elapsed_from_start / s->duration;
-                    s->start = (s->start + periods_skipped *s->duration) % max;
-                    s->current_ep = 0;
-                    s->state = ST_WAITING_START;
-                } else{
-                    s->state = ST_STOP;
-                    s->current_ep=0;
-                }
-            }
+        if(s->state == ST_WAITING_START){
+            if(e >= s->duration) continue;
+            s->state = ST_RUNNING;
+            s->current_ep = 0;
+        }
+
+        while(s->current_ep < s->num_eps && s->eps[s->current_ep].offset <= e)
+            e = sch_expire(s, e, max);
+        if(e < s->duration) continue;
+
+        if(s->next != OS_SCHTBL_NONE){
+            sch_handover(s, cur, max);
             continue;
         }
-        if(s->state == ST_RUNNING){
-            while (s->current_ep < s->num_eps && s->eps[s->current_ep].offset <= elapsed_from_start){
-                Expiry_Point *ep = &s->eps[s->current_ep];
-                switch(ep->action_type){
-                    case SCH_ACTIVATE_TASK:
-                        ActivateTask(ep->action.tid);
-                        break;
-                    case SCH_SET_EVENT:
-                        SetEvent(ep->action.Set_event.tid,ep->action.Set_event.mask);
-                        break;
-                    case SCH_CALLBACK:
-                        ep->action.callback_fn();
-                        break;
-                }   
-                s->current_ep++;
-            }
-            if(elapsed_from_start >= s->duration){
-                if(s->cyclic){
-                    TickType Period_skipped = elapsed_from_start / s->duration;
-                    s->start = (s->start + Period_skipped * s->duration) %max;
-                    s->current_ep = 0;
-                    s->state = ST_WAITING_START;
-
-                    TickType e2 = diff_wrap(cur, s->start, max);
-                    if (e2 < s->duration) {
-                        s->state = ST_RUNNING;
-                        while (s->current_ep < s->num_eps && s->eps[s->current_ep].offset <= e2) {
-                            Expiry_Point *ep = &s->eps[s->current_ep];
-                        switch(ep->action_type){
-                            case SCH_ACTIVATE_TASK:
-                                ActivateTask(ep->action.tid);
-                                break;
-                            case SCH_SET_EVENT:
-                                SetEvent(ep->action.Set_event.tid,ep->action.Set_event.mask);
-                                break;
-                            case SCH_CALLBACK:
-                                ep->action.callback_fn();
-                                break;
-                            }
-                            s->current_ep++;
-                         }
-                    }
-                 } else{
-                    s->state = ST_STOP;
-                    s->current_ep = 0;
-                 }
-            }
+        if(!s->cyclic){
+            s->state = ST_STOP;
+            s->current_ep = 0;
+            continue;
         }
-    }   
+        s->start = (s->start + (e / s->duration) * s->duration) % max;
+        s->current_ep = 0;
+        e = diff_wrap(cur, s->start, max);
+        while(s->current_ep < s->num_eps && s->eps[s->current_ep].offset <= e)
+            e = sch_expire(s, e, max);
+    }
 }
+#endif /* OS_CFG_SCHTBL */
 /* Alias nếu nơi khác gọi tên này */
 void os_tick_handler(void)
 {
@@ -569,6 +1936,10 @@ void OS_Init(void)
 {
     __disable_irq();
     os_port_init();
+    os_pool_init();
+#if (OS_CFG_TIMING_PROT)
+    tp_init();
+#endif
 
     /* Lưu entry/arg/stack top để tái dựng khi Activate */
     g_task_entry[TASK_INIT] = Task_Init;  g_task_arg[TASK_INIT] = 0; g_stack_top[TASK_INIT] = &stack_init[STACK_WORDS_INIT];
@@ -576,6 +1947,7 @@ void OS_Init(void)
     g_task_entry[TASK_B]    = Task_B;     g_task_arg[TASK_B]    = 0; g_stack_top[TASK_B]    = &stack_b[STACK_WORDS_B];
     g_task_entry[TASK_C]    = Task_C;     g_task_arg[TASK_C]    = 0; g_stack_top[TASK_C]    = &stack_c[STACK_WORDS_C];
     g_task_entry[TASK_IDLE] = Task_Idle;  g_task_arg[TASK_IDLE] = 0; g_stack_top[TASK_IDLE] = &stack_idle[STACK_WORDS_IDLE];
+    g_task_entry[TASK_D]    = Task_D;     g_task_arg[TASK_D]    = 0; g_stack_top[TASK_D]    = &stack_d[STACK_WORDS_D];
     /* Dựng stack lần đầu */
     tcb[TASK_INIT].sp    = os_task_stack_init(g_task_entry[TASK_INIT], g_task_arg[TASK_INIT], g_stack_top[TASK_INIT]);
     tcb[TASK_INIT].id    = TASK_INIT;
@@ -597,15 +1969,67 @@ void OS_Init(void)
     tcb[TASK_IDLE].id    = TASK_IDLE;
     tcb[TASK_IDLE].state = OS_READY;   /* không enqueue IDLE */
 
-    rq_head = rq_tail = 0;
+    tcb[TASK_D].sp       = os_task_stack_init(g_task_entry[TASK_D],    g_task_arg[TASK_D],    g_stack_top[TASK_D]);
+    tcb[TASK_D].id       = TASK_D;
+    tcb[TASK_D].state    = OS_DORMANT;
+
+#if (OS_CFG_TIMER_TASK)
+    g_task_entry[TASK_TIMER] = os_timer_task; g_task_arg[TASK_TIMER] = 0; g_stack_top[TASK_TIMER] = &stack_timer[STACK_WORDS_TIMER];
+    tcb[TASK_TIMER].sp    = os_task_stack_init(g_task_entry[TASK_TIMER], g_task_arg[TASK_TIMER], g_stack_top[TASK_TIMER]);
+    tcb[TASK_TIMER].id    = TASK_TIMER;
+    tcb[TASK_TIMER].state = OS_READY;  /* chạy tới WaitEvent rồi chờ */
+#endif
+#if (OS_CFG_PT)
+    g_task_entry[TASK_PT] = os_pt_task; g_task_arg[TASK_PT] = 0; g_stack_top[TASK_PT] = &stack_pt[STACK_WORDS_PT];
+    tcb[TASK_PT].sp    = os_task_stack_init(g_task_entry[TASK_PT], g_task_arg[TASK_PT], g_stack_top[TASK_PT]);
+    tcb[TASK_PT].id    = TASK_PT;
+    tcb[TASK_PT].state = OS_READY;     /* chạy mọi coroutine tới điểm chờ đầu */
+#endif
+#ifdef APP_BENCH
+    for (uint8_t i = 0u; i < OS_BENCH_TASKS; ++i) {
+        uint8_t id = (uint8_t)(TASK_BENCH0 + i);
+        g_task_entry[id] = Bench_Task; g_task_arg[id] = (void *)(uintptr_t)i; g_stack_top[id] = &stack_bench[i][STACK_WORDS_BENCH];
+        tcb[id].sp    = os_task_stack_init(g_task_entry[id], g_task_arg[id], g_stack_top[id]);
+        tcb[id].id    = id;
+        tcb[id].state = OS_DORMANT;
+    }
+#endif
+
+    /* Ưu tiên tĩnh + khung ban đầu (tái dùng khi Activate) + timer chờ */
+    for (uint8_t i = 0u; i < OS_MAX_IRES; ++i) {
+        ires_tasks |= ires_members[i];
+    }
+    for (uint8_t i = 0u; i < OS_MAX_TASKS; ++i) {
+        tcb[i].prio = g_task_prio[i];
+        g_task_frame[i] = tcb[i].sp;
+#if (OS_CFG_ISR_LATENCY)
+        tcb[i].rdy_isr = OS_ISR_NONE;
+#endif
+#if (OS_CFG_EVENTS)
+        task_tmo[i] = (OsAlarm_t){ OS_ACT_WAKEUP(i) };
+#endif
+    }
+#if (OS_CFG_ISR_LATENCY)
+    for (uint8_t i = 0u; i < OS_MAX_ISR2; ++i) {
+        os_perf_reset(&isr_lat[i]);
+    }
+#endif
+
+    rq_reset();
     (void)rq_push(TASK_INIT);
+#if (OS_CFG_TIMER_TASK)
+    (void)rq_push(TASK_TIMER);
+#endif
+#if (OS_CFG_PT)
+    (void)rq_push(TASK_PT);
+#endif
     g_current = &tcb[TASK_INIT];
 
     /* ví dụ alarm */
-    //SetRelAlarm(0u, 500u,  500u, TASK_A);
-    StartSchedulTblRel(0,50);
-    // SetRelAlarm(1u, 600u,  500u, TASK_B);
-    // SetRelAlarm(2u, 300u,  400u, TASK_C);
+    //SetRelAlarm(0u, 500u,  500u);
+    /* Schedule table: cấu hình + Start trong Setup_SchTbl (Task_Init) */
+    // SetRelAlarm(1u, 600u,  500u);
+    // SetRelAlarm(2u, 300u,  400u);
 
     __enable_irq();
 }
@@ -618,29 +2042,95 @@ void OS_Init(void)
  * ========================================================= */
 void OS_Start(void)
 {
+    OS_HOOK(StartupHook);
+#if (OS_CFG_TIMING_PROT)
+    tp_begin((TCB_t *)g_current);
+#endif
     __ASM volatile("svc 0");
 }
 
+/* =========================================================
+ *  ShutdownOS(): dừng hệ thống (lỗi không phục hồi được)
+ * ========================================================= */
+void ShutdownOS(StatusType error)
+{
+    __disable_irq();
+    OS_HOOK(ShutdownHook, error);
+    for (;;)
+    {
+        __NOP();
+    }
+}
+
 void SetUpAlarm(){
     alarm_to_counter[0] = &Counter_tbl[0];
     Counter_tbl[0].alarm_list[Counter_tbl[0].num_alarms++] = &alarm_tbl[0];
 
-    alarm_tbl[0].action_type = ALARMACTION_ACTIVATETASK;
-    alarm_tbl[0].action.target_task = TASK_A;
+    /* Activate chỉ có tác dụng khi task DORMANT → gộp chu kỳ lỡ */
+    alarm_tbl[0] = (OsAlarm_t){ OS_ACT_ACTIVATE(TASK_A), .catchup = ALARM_CATCHUP_ONCE };
+
+#ifndef APP_BENCH
+    /* AID 2: thăm dò nút (Task_C); AID 3: chẩn đoán nền (Task_D).
+     * Build benchmark dùng AID 2.. cho phép đo tick, Task_C là pong. */
+    for (uint8_t i = 2u; i <= 3u; ++i) {
+        alarm_to_counter[i] = &Counter_tbl[0];
+        Counter_tbl[0].alarm_list[Counter_tbl[0].num_alarms++] = &alarm_tbl[i];
+    }
+    alarm_tbl[2] = (OsAlarm_t){ OS_ACT_ACTIVATE(TASK_C), .catchup = ALARM_CATCHUP_SKIP };
+    alarm_tbl[3] = (OsAlarm_t){ OS_ACT_ACTIVATE(TASK_D), .catchup = ALARM_CATCHUP_SKIP };
+#endif
+
+#ifdef APP_BENCH
+    /* AID 1: callback chậm để đo thời gian ISR tick (app/App_Bench.c) */
+    alarm_to_counter[1] = &Counter_tbl[0];
+    Counter_tbl[0].alarm_list[Counter_tbl[0].num_alarms++] = &alarm_tbl[1];
+    alarm_tbl[1] = (OsAlarm_t){ OS_ACT_CALLBACK(OS_TIMER_SLOT_ALARM(1u), Bench_SlowCallback),
+                                .catchup = ALARM_CATCHUP_ONCE };
+
+    /* AID 2..: nhiều alarm hết hạn cùng 1 tick (SetEvent bit không ai chờ) */
+    for (uint8_t i = 2u; i < OS_MAX_ALARMS; ++i) {
+        alarm_to_counter[i] = &Counter_tbl[0];
+        /* TASK_INIT đang chạy bench */
+        alarm_tbl[i] = (OsAlarm_t){ OS_ACT_SETEVENT(TASK_INIT, 0x20000000u) };
+    }
+#endif
 
 }
 
+#if (OS_CFG_SCHTBL)
 void Setup_SchTbl(void){
-    OsSchedTbl *s = &Schedule_Table_List[0];
+    for(uint8_t i = 0u; i < OS_MAX_SchedTbl; i++){
+        Schedule_Table_List[i].counter = &Counter_tbl[0];
+        Schedule_Table_List[i].cyclic = 1;
+        Schedule_Table_List[i].next = OS_SCHTBL_NONE;
+    }
 
-    s->counter = &Counter_tbl[0];
-    s->cyclic = 1;
+    OsSchedTbl *s = &Schedule_Table_List[SCHTBL_MAIN];
     s->duration = 5000;
-    s->num_eps = 3;
-
-    s->eps[0] = (Expiry_Point) {.offset = 0,    .action_type  = SCH_ACTIVATE_TASK,  .action.tid = TASK_A};
-    s->eps[1] = (Expiry_Point) {.offset = 2000, .action_type  = SCH_ACTIVATE_TASK,  .action.tid = TASK_B};
-    //s->eps[2] = (Expiry_Point) {.offset = 8000, .action_type  = SCH_CALLBACK,  .action.callback_fn = SetMode_Off};
-
+    s->num_eps = 1;
+    s->precision = 2;       /* ±2 ms so với thời gian mạng → đồng bộ */
+    s->eps[0] = (Expiry_Point) {.offset = 2000, .max_advance = 50, .max_retard = 50, OS_ACT_ACTIVATE(TASK_B)};
+    //s->eps[1] = (Expiry_Point) {.offset = 4000, OS_ACT_CALLBACK(OS_TIMER_SLOT_EP(SCHTBL_MAIN, 1u), SetMode_Off)};
+
+    /* Chế độ xe: nhịp LED PC13 nằm trong chu kỳ bảng, Task_A chỉ đảo LED */
+    s = &Schedule_Table_List[SCHTBL_MODE_NORMAL];
+    s->duration = 150;
+    s->num_eps = 1;
+    s->eps[0] = (Expiry_Point) {.offset = 0, OS_ACT_ACTIVATE(TASK_A)};
+
+    s = &Schedule_Table_List[SCHTBL_MODE_WARNING];
+    s->duration = 50;
+    s->num_eps = 1;
+    s->eps[0] = (Expiry_Point) {.offset = 0, OS_ACT_ACTIVATE(TASK_A)};
+
+    s = &Schedule_Table_List[SCHTBL_MODE_OFF];
+    s->duration = 1000;
+#if (OS_CFG_ALARM_CALLBACK)
+    s->num_eps = 1;
+    s->eps[0] = (Expiry_Point) {.offset = 0, OS_ACT_CALLBACK(OS_TIMER_SLOT_EP(SCHTBL_MODE_OFF, 0u), Mode_LedOff)};
+#endif
 
+    StartSchedulTblRel(SCHTBL_MAIN, 50);
+    StartSchedulTblRel(SCHTBL_MODE_NORMAL, 0);  /* g_mode_sig khởi đầu = MODE_NORMAL */
 }
+#endif /* OS_CFG_SCHTBL */
@@ -0,0 +1,93 @@
+/*
+ * =====================================================================
+ *  Deferred binary log – hiện thực
+ *  - Producer (nhiều, Task/ISR): giành chỗ bằng CAS trên s_log_wr,
+ *    ghi tham số, rồi ghi hdr CUỐI CÙNG (hdr có OS_LOG_COMMIT = commit).
+ *  - Consumer (1): đọc từ s_log_rd, dừng ở bản ghi chưa commit,
+ *    xoá word đã đọc về 0 để lần quay vòng sau không đọc nhầm hdr cũ.
+ *  - Chỉ số chạy tự do (free-running), & MASK khi truy cập mảng.
+ * =====================================================================
+ */
+
+#include "os_log.h"
+#include "os_atomic.h"
+
+#include <stdint.h>
+
+#if (OS_LOG_BUF_WORDS & (OS_LOG_BUF_WORDS - 1u)) != 0u
+#error "OS_LOG_BUF_WORDS must be a power of 2"
+#endif
+
+#define OS_LOG_MASK     (OS_LOG_BUF_WORDS - 1u)
+
+static volatile uint32_t s_log_buf[OS_LOG_BUF_WORDS];
+static volatile uint32_t s_log_wr = 0u;     /* vị trí giành chỗ tiếp theo */
+static volatile uint32_t s_log_rd = 0u;     /* vị trí consumer đọc       */
+static volatile uint32_t s_log_dropped = 0u;
+
+void os_log_write(uint16_t id, const uint32_t *args, uint8_t nargs)
+{
+    uint32_t need = 1u + nargs;
+    uint32_t wr;
+
+    /* 1) Giành chỗ 'need' word (lock-free) */
+    do {
+        wr = __LDREXW(&s_log_wr);
+        if ((wr + need) - s_log_rd > OS_LOG_BUF_WORDS) {
+            __CLREX();
+            (void)os_atomic_add32(&s_log_dropped, 1u);
+            return;
+        }
+    } while (__STREXW(wr + need, &s_log_wr) != 0u);
+
+    /* 2) Ghi tham số */
+    for (uint8_t i = 0u; i < nargs; ++i) {
+        s_log_buf[(wr + 1u + i) & OS_LOG_MASK] = args[i];
+    }
+
+    /* 3) Commit: hdr phải được thấy SAU tham số */
+    __DMB();
+    s_log_buf[wr & OS_LOG_MASK] = OS_LOG_HDR(id, nargs);
+}
+
+static inline void log_put_word(void (*put)(uint8_t), uint32_t w)
+{
+    put((uint8_t)(w));
+    put((uint8_t)(w >> 8));
+    put((uint8_t)(w >> 16));
+    put((uint8_t)(w >> 24));
+}
+
+uint32_t OS_LogDrain(void (*put)(uint8_t b), uint32_t max_records)
+{
+    uint32_t done = 0u;
+
+    while (done < max_records) {
+        uint32_t rd = s_log_rd;
+        if (rd == s_log_wr)
+            break;
+
+        uint32_t hdr = s_log_buf[rd & OS_LOG_MASK];
+        if ((hdr & 0xFFu) != OS_LOG_COMMIT)
+            break;                      /* producer còn đang ghi dở */
+        __DMB();
+
+        uint32_t n = (hdr >> 8) & 0x0Fu;
+        for (uint32_t i = 0u; i <= n; ++i) {
+            uint32_t idx = (rd + i) & OS_LOG_MASK;
+            log_put_word(put, s_log_buf[idx]);
+            s_log_buf[idx] = 0u;
+        }
+
+        /* Trả chỗ cho producer sau khi đã xoá xong */
+        __DMB();
+        s_log_rd = rd + 1u + n;
+        done++;
+    }
+    return done;
+}
+
+uint32_t OS_LogGetDropped(void)
+{
+    return s_log_dropped;
+}
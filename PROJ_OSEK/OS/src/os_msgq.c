@@ -0,0 +1,123 @@
+/*
+ * =====================================================================
+ *  Message queue có chặn – hiện thực
+ *  - Toàn bộ thao tác trong vùng tới hạn ngắn (__disable_irq).
+ *  - Task chờ gửi: wait_data trỏ tới thông điệp của nó.
+ *    Task chờ nhận: wait_data trỏ tới bộ đệm nhận của nó.
+ * =====================================================================
+ */
+
+#include "os_msgq.h"
+#include "os_internal.h"
+#include "stm32f10x.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+#if (OS_MAX_MSGQ > 0u)
+
+/* =========================================================
+ *  Cấu hình queue (tĩnh)
+ * ========================================================= */
+#ifdef APP_BENCH
+static uint8_t msgq_buf_bench_req[4u * sizeof(uint32_t)];
+static uint8_t msgq_buf_bench_rsp[4u * sizeof(uint32_t)];
+#endif
+
+static const OsMsgQCfg_t msgq_cfg[OS_MAX_MSGQ] = {
+#ifdef APP_BENCH
+    [MSGQ_BENCH_REQ] = { .msg_size = sizeof(uint32_t), .depth = 4u, .buf = msgq_buf_bench_req },
+    [MSGQ_BENCH_RSP] = { .msg_size = sizeof(uint32_t), .depth = 4u, .buf = msgq_buf_bench_rsp },
+#endif
+};
+
+static OsMsgQRt_t msgq_rt[OS_MAX_MSGQ];
+
+static inline void msgq_copy(uint8_t *dst, const uint8_t *src, uint8_t n)
+{
+    while (n--) {
+        *dst++ = *src++;
+    }
+}
+
+/* Chép msg vào cuối ring (caller đảm bảo còn chỗ) */
+static inline void msgq_put(const OsMsgQCfg_t *c, OsMsgQRt_t *r, const void *msg)
+{
+    uint8_t tail = (uint8_t)((r->head + r->count) % c->depth);
+    msgq_copy(&c->buf[tail * c->msg_size], (const uint8_t *)msg, c->msg_size);
+    r->count++;
+}
+
+uint8_t MsgQSend(uint8_t qid, const void *msg, TickType timeout)
+{
+    if (qid >= OS_MAX_MSGQ)
+        return MSGQ_E_ID;
+
+    const OsMsgQCfg_t *c = &msgq_cfg[qid];
+    OsMsgQRt_t *r = &msgq_rt[qid];
+    uint8_t rc = MSGQ_E_OK;
+
+    __disable_irq();
+    TCB_t *rx = os_waitq_pop(&r->rx_wait);
+    if (rx != NULL) {
+        /* Hand-off: chép thẳng vào bộ đệm của task đang chờ nhận */
+        msgq_copy((uint8_t *)rx->wait_data, (const uint8_t *)msg, c->msg_size);
+        os_release_task(rx, OS_WAIT_OK);
+    } else if (r->count < c->depth) {
+        msgq_put(c, r, msg);
+    } else if (timeout == 0u || os_in_isr()) {
+        rc = MSGQ_E_FULL;
+    } else {
+        /* Đầy: chờ; task nhận sẽ chép thông điệp của ta vào ring */
+        if (os_wait_current(&r->tx_wait, (void *)msg, timeout) != OS_WAIT_OK)
+            rc = MSGQ_E_TIMEOUT;
+    }
+    __enable_irq();
+    return rc;
+}
+
+uint8_t MsgQReceive(uint8_t qid, void *msg, TickType timeout)
+{
+    if (qid >= OS_MAX_MSGQ)
+        return MSGQ_E_ID;
+
+    const OsMsgQCfg_t *c = &msgq_cfg[qid];
+    OsMsgQRt_t *r = &msgq_rt[qid];
+    uint8_t rc = MSGQ_E_OK;
+
+    __disable_irq();
+    if (r->count > 0u) {
+        msgq_copy((uint8_t *)msg, &c->buf[r->head * c->msg_size], c->msg_size);
+        r->head = (uint8_t)((r->head + 1u) % c->depth);
+        r->count--;
+
+        /* Vừa có chỗ: nhận thông điệp của task gửi ưu tiên cao nhất */
+        TCB_t *tx = os_waitq_pop(&r->tx_wait);
+        if (tx != NULL) {
+            msgq_put(c, r, tx->wait_data);
+            os_release_task(tx, OS_WAIT_OK);
+        }
+    } else if (timeout == 0u || os_in_isr()) {
+        rc = MSGQ_E_EMPTY;
+    } else {
+        /* Rỗng: chờ; task gửi sẽ chép thẳng vào 'msg' */
+        if (os_wait_current(&r->rx_wait, msg, timeout) != OS_WAIT_OK)
+            rc = MSGQ_E_TIMEOUT;
+    }
+    __enable_irq();
+    return rc;
+}
+
+#else /* OS_MAX_MSGQ == 0: không có queue nào được cấu hình */
+
+uint8_t MsgQSend(uint8_t qid, const void *msg, TickType timeout)
+{
+    return MSGQ_E_ID;
+}
+
+uint8_t MsgQReceive(uint8_t qid, void *msg, TickType timeout)
+{
+    return MSGQ_E_ID;
+}
+
+#endif /* OS_MAX_MSGQ */
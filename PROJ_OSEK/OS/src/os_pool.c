@@ -0,0 +1,128 @@
+/*
+ * =====================================================================
+ *  Pool khối cố định – hiện thực
+ *  - Khối rỗi: word đầu tiên chứa địa chỉ khối rỗi kế tiếp (0 = hết).
+ *  - Pop/push đỉnh danh sách bằng LDREX/STREX. Trên Cortex-M3 monitor
+ *    bị xoá khi vào/ra ngắt, nên ISR chen giữa LDREX..STREX làm STREX
+ *    thất bại → không có lỗi ABA với lõi đơn.
+ * =====================================================================
+ */
+
+#include "os_pool.h"
+#include "os_atomic.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* =========================================================
+ *  Cấu hình pool (tĩnh) – storage dạng uint32_t để căn 4 byte
+ * ========================================================= */
+#define POOL_WORDS(sz, n)   (((sz) / 4u) * (n))
+
+static uint32_t pool_mem_16[POOL_WORDS(16u, 16u)];
+static uint32_t pool_mem_32[POOL_WORDS(32u, 8u)];
+static uint32_t pool_mem_64[POOL_WORDS(64u, 4u)];
+
+static const OsPoolCfg_t pool_cfg[OS_MAX_POOL] = {
+    [POOL_16] = { .block_size = 16u, .num_blocks = 16u, .storage = pool_mem_16 },
+    [POOL_32] = { .block_size = 32u, .num_blocks = 8u,  .storage = pool_mem_32 },
+    [POOL_64] = { .block_size = 64u, .num_blocks = 4u,  .storage = pool_mem_64 },
+};
+
+typedef struct {
+    volatile uint32_t free;         /* địa chỉ khối rỗi đầu tiên */
+    volatile uint32_t used;
+    volatile uint32_t high_water;
+    volatile uint32_t fails;
+} OsPoolRt_t;
+
+static OsPoolRt_t pool_rt[OS_MAX_POOL];
+
+__attribute__((weak)) void PoolExhaustedHook(uint8_t pid)
+{
+    (void)pid;
+}
+
+void os_pool_init(void)
+{
+    for (uint8_t p = 0u; p < OS_MAX_POOL; ++p) {
+        const OsPoolCfg_t *c = &pool_cfg[p];
+        uint32_t words = c->block_size / 4u;
+        uint32_t head = 0u;
+
+        /* Nối từ khối cuối về khối đầu → PoolAlloc cấp theo thứ tự địa chỉ */
+        for (uint32_t i = c->num_blocks; i-- > 0u; ) {
+            uint32_t *blk = &c->storage[i * words];
+            blk[0] = head;
+            head = (uint32_t)(uintptr_t)blk;
+        }
+        pool_rt[p].free = head;
+        pool_rt[p].used = 0u;
+        pool_rt[p].high_water = 0u;
+        pool_rt[p].fails = 0u;
+    }
+}
+
+void *PoolAlloc(uint8_t pid)
+{
+    if (pid >= OS_MAX_POOL)
+        return NULL;
+
+    OsPoolRt_t *r = &pool_rt[pid];
+    uint32_t head;
+
+    do {
+        head = __LDREXW(&r->free);
+        if (head == 0u) {
+            __CLREX();
+            (void)os_atomic_add32(&r->fails, 1u);
+            PoolExhaustedHook(pid);
+            return NULL;
+        }
+    } while (__STREXW(*(uint32_t *)(uintptr_t)head, &r->free) != 0u);
+
+    os_atomic_max32(&r->high_water, os_atomic_add32(&r->used, 1u));
+    return (void *)(uintptr_t)head;
+}
+
+void *PoolAllocSize(uint32_t size)
+{
+    /* pool_cfg xếp theo block_size tăng dần */
+    for (uint8_t p = 0u; p < OS_MAX_POOL; ++p) {
+        if (pool_cfg[p].block_size >= size)
+            return PoolAlloc(p);
+    }
+    return NULL;
+}
+
+void PoolFree(void *blk)
+{
+    uint32_t addr = (uint32_t)(uintptr_t)blk;
+
+    for (uint8_t p = 0u; p < OS_MAX_POOL; ++p) {
+        const OsPoolCfg_t *c = &pool_cfg[p];
+        uint32_t base = (uint32_t)(uintptr_t)c->storage;
+        if (addr < base || addr >= base + (uint32_t)c->block_size * c->num_blocks)
+            continue;
+
+        OsPoolRt_t *r = &pool_rt[p];
+        uint32_t head;
+        do {
+            head = __LDREXW(&r->free);
+            *(uint32_t *)blk = head;
+        } while (__STREXW(addr, &r->free) != 0u);
+
+        (void)os_atomic_add32(&r->used, (uint32_t)-1);
+        return;
+    }
+    /* Con trỏ không thuộc pool nào → bỏ qua */
+}
+
+void PoolGetStats(uint8_t pid, OsPoolStats_t *out)
+{
+    if (pid >= OS_MAX_POOL || out == NULL)
+        return;
+    out->used = pool_rt[pid].used;
+    out->high_water = pool_rt[pid].high_water;
+    out->fails = pool_rt[pid].fails;
+}
@@ -54,6 +54,21 @@ void os_port_init(void)
 
     /* 3) Bật SysTick theo OS_TICK_HZ (mặc định 1000 Hz nếu không đổi) */
     os_port_start_systick(OS_TICK_HZ);
+
+    /* 4) Bộ đếm chu kỳ cho đo đạc */
+    os_port_cycle_init();
+}
+
+/* ============================================================
+ *  DWT->CYCCNT: đếm chu kỳ HCLK (72 MHz → tràn sau ~59 s)
+ *  - Cần TRCENA trong CoreDebug->DEMCR (có debugger hay không đều được).
+ * ============================================================
+ */
+void os_port_cycle_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
 }
 
 /* ============================================================
@@ -80,24 +95,60 @@ void os_port_start_systick(uint32_t tick_hz)
                     SysTick_CTRL_ENABLE_Msk;
 }
 
+/* ============================================================
+ *  TIM2: timer cưỡng chế ngân sách thực thi (bảo vệ thời gian)
+ *  - Đếm tự do 1 MHz (TIM2CLK = HCLK khi APB1 chia 2), CCR1 = mốc hết hạn.
+ *  - Ưu tiên NVIC 0: chen được cả SysTick; vẫn bị PRIMASK của kernel chặn.
+ * ============================================================
+ */
+void os_port_tp_init(void)
+{
+    RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
+    TIM2->CR1  = 0u;
+    TIM2->PSC  = (uint16_t)((SystemCoreClock / 1000000u) - 1u);
+    TIM2->ARR  = 0xFFFFu;
+    TIM2->DIER = 0u;
+    TIM2->EGR  = TIM_EGR_UG;            /* nạp PSC ngay */
+    TIM2->SR   = 0u;
+    TIM2->CR1  = TIM_CR1_CEN;
+
+    NVIC_SetPriority(TIM2_IRQn, 0u);
+    NVIC_EnableIRQ(TIM2_IRQn);
+}
+
+void os_port_tp_arm(uint32_t us)
+{
+    if (us == 0u)      us = 1u;
+    if (us > 0xFFFFu)  us = 0xFFFFu;
+    uint16_t now = (uint16_t)TIM2->CNT;
+    TIM2->SR   = (uint16_t)~TIM_SR_CC1IF;  /* xoá cờ cũ TRƯỚC khi đặt mốc: khớp sau đó không mất */
+    TIM2->CCR1 = (uint16_t)(now + us);
+    TIM2->DIER = TIM_DIER_CC1IE;
+    /* CNT đã vượt mốc trước khi CCR1 được ghi (us rất nhỏ) → compare chỉ
+     * khớp ở vòng đếm sau: tự kích ngắt (ISR tự kiểm lại ngân sách) */
+    if ((uint16_t)(TIM2->CNT - now) >= us)
+        NVIC_SetPendingIRQ(TIM2_IRQn);
+}
+
+void os_port_tp_disarm(void)
+{
+    TIM2->DIER = 0u;
+    TIM2->SR   = (uint16_t)~TIM_SR_CC1IF;
+    NVIC_ClearPendingIRQ(TIM2_IRQn);    /* khớp ngay trước PendSV: không rơi sang task kế */
+}
+
 /* ============================================================
  *  Kích hoạt PendSV (yêu cầu đổi ngữ cảnh)
- *  - Việc đổi thực sự sẽ diễn ra khi thoát ISR hiện tại.
- *  - DSB/ISB đảm bảo hiệu lực ghi trước khi rẽ nhánh/thoát ngắt.
+ *  - Việc đổi thực sự sẽ diễn ra khi thoát ISR hiện tại / khi caller
+ *    mở lại IRQ (kernel luôn gọi trong vùng __disable_irq).
+ *  - Không cần barrier: ICSR thuộc SCS (strongly-ordered) nên ghi
+ *    g_next trước đó đã hoàn tất; CPSIE/exception return tự đồng bộ.
+ *  - Kernel không dùng BASEPRI (os_port_init đặt 0 một lần).
  * ============================================================
  */
 void os_trigger_pendsv(void)
 {
-    /* Xoá BASEPRI (nếu kernel từng dùng), cho phép mọi mức ưu tiên */
-    __set_BASEPRI(0);
-    __DSB();
-    __ISB();
-
-    /* Set bit PENDSVSET trong ICSR */
     SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
-
-    __DSB();
-    __ISB();
 }
 
 /* ============================================================
@@ -113,19 +164,6 @@ OS_NORETURN void os_task_exit(void)
     }
 }
 
-/* ------------------------------------------------------------
- *  "task_bootstrap_exit": được gán vào LR của HW-frame ban đầu.
- *  Nếu entry() return → CPU sẽ nhảy vào đây → thoát vĩnh viễn.
- * ------------------------------------------------------------
- */
-static void task_bootstrap_exit(void) OS_NORETURN;
-static void task_bootstrap_exit(void)
-{
-    os_task_exit();
-    /* không bao giờ chạy tới đây */
-    __builtin_unreachable();
-}
-
 /* ============================================================
  *  Dựng stack PSP ban đầu cho task entry(void *arg)
  *
@@ -156,7 +194,7 @@ uint32_t *os_task_stack_init(TaskEntry entry,
      */
     *(--sp) = 0x01000000u;                         /* xPSR: T-bit=1 (Thumb) */
     *(--sp) = ((uint32_t)entry) | 1u;              /* PC: địa chỉ hàm entry | 1 */
-    *(--sp) = ((uint32_t)task_bootstrap_exit) | 1u;/* LR: nếu entry return → thoát */
+    *(--sp) = ((uint32_t)os_task_exit) | 1u;       /* LR: nếu entry return → thoát */
     *(--sp) = 0x12121212u;                         /* R12 */
     *(--sp) = 0x00000000u;                         /* R3  */
     *(--sp) = 0x00000000u;                         /* R2  */
@@ -23,8 +23,16 @@
 
     .extern g_current
     .extern g_next
+    .extern g_discard
     .extern os_on_tick
 
+/* Hook OSEK do ứng dụng định nghĩa (C): tham chiếu WEAK → không định
+ * nghĩa thì địa chỉ = 0 và handler bỏ qua (LDR + CBZ, không gọi hàm). */
+    .weak   PreTaskHook
+    .weak   PostTaskHook
+/* Kế toán ngân sách của kernel (chỉ có khi OS_CFG_TIMING_PROT = 1) */
+    .weak   os_tp_switch
+
     .global PendSV_Handler
     .global SysTick_Handler
     .global SVC_Handler
@@ -34,43 +42,80 @@
  *
  * Mục tiêu:
  *  1) Nếu có g_next:
- *     - Lưu (SAVE) R4..R11 của task hiện hành vào stack (PSP).
- *     - Cập nhật current->sp = PSP (lúc này đang là &R4 sau khi PUSH).
+ *     - Lưu (SAVE) R4..R11 của task hiện hành vào stack (PSP) và cập nhật
+ *       current->sp = &R4 — TRỪ KHI current == g_discard (task vừa
+ *       TerminateTask: ngữ cảnh bị bỏ, Activate sau sẽ dựng stack mới).
  *     - Phục hồi (RESTORE) R4..R11 của task kế tiếp từ next->sp.
  *     - Đặt PSP = &R0 (đầu HW-frame) của task kế tiếp.
  *     - Gán g_current = g_next; và xóa g_next = NULL.
  *  2) Nếu KHÔNG có g_next → thoát nhanh, không làm gì.
+ *  3) PostTaskHook() trước khi đổi (g_current = task cũ), PreTaskHook()
+ *     sau khi đổi (g_current = task mới) – chỉ khi ứng dụng có định nghĩa.
+ *     Hook chạy trong PendSV với IRQ tắt: phải ngắn, không gọi API chặn.
+ *  4) os_tp_switch(g_current, g_next) nếu kernel bật bảo vệ thời gian.
  *
  * Lưu ý:
+ *  - CPSID i quanh đoạn đọc/ghi g_next/g_current: ISR ưu tiên cao hơn
+ *    không thể chen giữa lúc vé đã xoá mà g_current chưa đổi (nếu chen,
+ *    schedule() sẽ thấy g_next = NULL và chọn thêm 1 task → mất task
+ *    vừa được chọn). Vé mới đặt SAU đó làm PendSV pending lại → phần
+ *    cứng tail-chain thẳng vào handler này, không unstack/restack.
+ *  - Không DSB/ISB: MSR psp + exception return (BX lr với EXC_RETURN)
+ *    đã là điểm đồng bộ ngữ cảnh trên ARMv7-M.
  *  - Trong Handler mode, LR giữ EXC_RETURN. BX LR sẽ kích hoạt logic
  *    “exception return”: phần cứng tự POP HW-frame từ PSP (nếu EXC_RETURN chọn PSP),
  *    và chuyển về Thread mode/PSP tiếp tục task.
  * ========================================================================= */
     .thumb_func
 PendSV_Handler:
+    CPSID   i
     /* [B1] Kiểm tra có task kế tiếp không (g_next != NULL) */
     LDR     r1, =g_next           /* r1 = &g_next */
     LDR     r2, [r1]              /* r2 = g_next (TCB*) */
     CBZ     r2, pend_exit         /* nếu r2 == 0 → không có next, thoát handler */
 
-    /* [B2] Lưu ngữ cảnh task hiện hành vào PSP (nếu PSP hợp lệ) */
+    /* PostTaskHook (task cũ vẫn là g_current); giữ r1/r2 + EXC_RETURN */
+    LDR     r0, =PostTaskHook
+    CBZ     r0, pend_post_done
+    PUSH    {r1, r2, r3, lr}      /* 4 word: giữ MSP căn 8 byte */
+    BLX     r0
+    POP     {r1, r2, r3, lr}
+pend_post_done:
+
+    /* os_tp_switch(from = g_current, to = g_next) */
+    LDR     r3, =os_tp_switch
+    CBZ     r3, pend_tp_done
+    PUSH    {r1, r2, r3, lr}
+    LDR     r0, =g_current
+    LDR     r0, [r0]
+    MOV     r1, r2
+    BLX     r3
+    POP     {r1, r2, r3, lr}
+pend_tp_done:
+
+    LDR     r3, =g_current        /* r3 = &g_current */
+    LDR     r12, [r3]             /* r12 = g_current (TCB*) */
+
+    /* [B2] Task vừa Terminate → bỏ ngữ cảnh, không SAVE */
+    LDR     r0, =g_discard
+    LDR     r3, [r0]              /* r3 = g_discard */
+    CMP     r3, r12
+    BNE     pend_save
+    MOVS    r3, #0
+    STR     r3, [r0]              /* g_discard = NULL (đã tiêu thụ) */
+    B       pend_no_save
+
+pend_save:
+    /* [B3] Lưu ngữ cảnh task hiện hành vào PSP (nếu PSP hợp lệ) */
     MRS     r0, psp               /* r0 = PSP hiện tại (trỏ &R0 nếu chưa SAVE SW-frame) */
     CBZ     r0, pend_no_save      /* nếu PSP = 0 (chưa chạy task nào) → bỏ qua SAVE */
 
-    /* PUSH {r4-r11} xuống stack của task hiện hành:
-     *  - STMDB r0!, {r4-r11} giảm r0 rồi lưu: sau lệnh, r0 trỏ &R4 (đầu SW-frame).
-     *  - Ghi nhớ: ta muốn current->sp = &R4.
-     */
+    /* PUSH {r4-r11}: sau lệnh, r0 trỏ &R4 (đầu SW-frame) */
     STMDB   r0!, {r4-r11}
-
-    /* current->sp = &R4 (giá trị r0 vừa cập nhật) */
-    LDR     r3, =g_current        /* r3 = &g_current */
-    LDR     r12, [r3]             /* r12 = g_current (TCB*) */
     STR     r0, [r12]             /* (*g_current).sp = r0 (= &R4) */
 
 pend_no_save:
-    /* [B3] Chuẩn bị chuyển sang task kế tiếp (next) */
-    /* r2 đang là g_next (TCB*) ở trên */
+    /* [B4] Chuyển sang task kế tiếp (r2 = next) */
     LDR     r0, [r2]              /* r0 = next->sp (= &R4 của next) */
 
     /* Gán current = next; và xóa next = NULL (đã tiêu thụ) */
@@ -79,28 +124,23 @@ pend_no_save:
     MOVS    r3, #0
     STR     r3, [r1]              /* g_next = NULL */
 
-    /* [B4] Phục hồi SW-frame của next và cập nhật PSP:
-     *  - LDMIA r0!, {r4-r11}: nạp R4..R11 từ vùng SW-frame của next,
-     *    đồng thời r0 tiến tới &R0 (đầu HW-frame).
+    /* [B5] Phục hồi SW-frame của next và cập nhật PSP:
+     *  - LDMIA r0!, {r4-r11}: nạp R4..R11, r0 tiến tới &R0 (đầu HW-frame).
      *  - MSR psp, r0: đặt PSP = &R0 của next.
-     *  Khi BX LR (exception return), phần cứng tự POP HW-frame của next
-     *  (R0..xPSR) → nhảy về PC của next, tiếp tục chạy Thread mode/PSP.
      */
     LDMIA   r0!, {r4-r11}         /* pop SW-frame → r0 = &R0 (đầu HW-frame) */
     MSR     psp, r0               /* PSP = &R0 của next */
 
-    /* Hàng rào bộ nhớ/điều khiển luồng để chắc chắn cập nhật PSP/ghi bộ nhớ được
-     * nhìn thấy đúng trước khi rời Handler.
-     */
-    DSB
-    ISB
+    /* PreTaskHook (g_current = task mới); R4..R11 của next được hàm C bảo toàn */
+    LDR     r0, =PreTaskHook
+    CBZ     r0, pend_exit
+    PUSH    {r0, lr}
+    BLX     r0
+    POP     {r0, lr}
 
 pend_exit:
-    /* [B5] Thoát handler.
-     *  - Nếu có next: LR đang là EXC_RETURN (ví dụ 0xFFFFFFFD),
-     *    BX LR sẽ exception return về Thread/PSP của next.
-     *  - Nếu không có next: quay về task hiện hành như cũ.
-     */
+    /* [B6] Mở IRQ và thoát handler (về next, hoặc về task cũ nếu không có next) */
+    CPSIE   i
     BX      lr
 
 /* =========================================================================
@@ -147,6 +187,12 @@ SVC_Handler:
     /* [C3] PSP = &R0 để chuẩn bị exception return */
     MSR   psp, r0                 /* PSP = &R0 (đầu HW-frame) */
 
+    /* PreTaskHook cho task đầu tiên (nếu có) */
+    LDR   r0, =PreTaskHook
+    CBZ   r0, svc_no_hook
+    BLX   r0
+svc_no_hook:
+
     /* [C4] Chọn PSP cho Thread mode (CONTROL.SPSEL = 1), vẫn privileged (n bit = 0) */
     MOVS  r0, #2                  /* 0b10: SPSEL=1, nPRIV=0 */
     MSR   control, r0
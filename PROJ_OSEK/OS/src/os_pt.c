@@ -0,0 +1,130 @@
+/*
+ * =====================================================================
+ *  Coroutine không stack – TASK_PT chạy các coroutine đã cấu hình
+ *  - PtSetEvent(): OR event vào coroutine, OR bit vào pt_ready
+ *    (LDREX/STREX, không tắt IRQ); bit đầu tiên từ trạng thái rỗng →
+ *    SetEvent(TASK_PT) (các bit sau không cần báo lại).
+ *  - TASK_PT lấy pt_ready bằng 1 lệnh xchg, cộng các coroutine hết
+ *    PT_DELAY, chạy từng cái theo thứ tự id. Hết việc → WaitEvent, có
+ *    timeout tới mốc PT_DELAY gần nhất (không cần tick riêng).
+ * =====================================================================
+ */
+
+#include "os_pt.h"
+#include "os_internal.h"
+#include "os_atomic.h"
+#include "stm32f10x.h"
+
+#include <stdint.h>
+
+#if (OS_CFG_PT)
+
+#define PT_EV_RUN           1u
+
+#if __STDC_VERSION__ >= 201112L
+_Static_assert(OS_MAX_PT < 32u, "pt_ready is a 32-bit coroutine mask");
+#endif
+
+/* =========================================================
+ *  Cấu hình coroutine (tĩnh) – thân do ứng dụng cung cấp
+ * ========================================================= */
+extern uint8_t Pt_ButtonLed(OsPt_t *pt);
+#ifdef APP_BENCH
+extern uint8_t Bench_PtPong(OsPt_t *pt);
+#endif
+
+static const OsPtFn pt_cfg[OS_MAX_PT] = {
+    [PT_BUTTON_LED] = Pt_ButtonLed,
+#ifdef APP_BENCH
+    [PT_BENCH]      = Bench_PtPong,
+#endif
+};
+
+static OsPt_t pt_rt[OS_MAX_PT];
+/* Lần chạy đầu: mọi coroutine tới điểm chờ đầu tiên */
+static volatile uint32_t pt_ready = (1u << OS_MAX_PT) - 1u;
+
+StatusType PtSetEvent(uint8_t pt_id, EventMaskType mask)
+{
+    if (pt_id >= OS_MAX_PT)
+        return E_OS_ID;
+
+    (void)os_atomic_or32(&pt_rt[pt_id].ev, mask);
+    __DMB();                        /* event phải thấy trước bit ready */
+    if (os_atomic_or32(&pt_ready, 1u << pt_id) == 0u) {
+        SetEvent(TASK_PT, PT_EV_RUN);
+    }
+    return E_OK;
+}
+
+void PtClearEvent(OsPt_t *pt, EventMaskType mask)
+{
+    (void)os_atomic_and32(&pt->ev, ~mask);
+}
+
+void os_pt_arm(OsPt_t *pt, TickType ticks)
+{
+    pt->wake  = os_tick_now() + ticks;
+    pt->timed = 1u;
+}
+
+bool os_pt_expired(OsPt_t *pt)
+{
+    if (pt->timed && ((int32_t)(os_tick_now() - pt->wake) < 0))
+        return false;
+    pt->timed = 0u;
+    return true;
+}
+
+/* Bitmap coroutine hết PT_DELAY; *next = số tick tới mốc gần nhất còn
+ * lại (0 = không coroutine nào đang PT_DELAY) */
+static uint32_t pt_timers(TickType *next)
+{
+    TickType now = os_tick_now();
+    uint32_t due = 0u;
+
+    *next = 0u;
+    for (uint32_t i = 0u; i < OS_MAX_PT; ++i) {
+        if (!pt_rt[i].timed)
+            continue;
+        int32_t left = (int32_t)(pt_rt[i].wake - now);
+        if (left <= 0) {
+            due |= 1u << i;
+        } else if ((*next == 0u) || ((TickType)left < *next)) {
+            *next = (TickType)left;
+        }
+    }
+    return due;
+}
+
+void os_pt_task(void *arg)
+{
+    (void)arg;
+    TickType next;
+
+    for (;;) {
+        uint32_t run = os_atomic_xchg32(&pt_ready, 0u);
+        __DMB();
+        run |= pt_timers(&next);
+
+        while (run != 0u) {
+            uint32_t id = __CLZ(__RBIT(run));   /* bit thấp nhất */
+            run &= run - 1u;
+            if (pt_cfg[id](&pt_rt[id]) == PT_YIELDED) {
+                (void)os_atomic_or32(&pt_ready, 1u << id);
+            }
+        }
+
+        if (pt_ready != 0u)
+            continue;
+        (void)pt_timers(&next);
+        if (next == 0u) {
+            WaitEvent(PT_EV_RUN);
+        } else {
+            WaitEventTimeout(PT_EV_RUN, next);
+        }
+        ClearEvent(PT_EV_RUN | OS_EVENT_TIMEOUT);
+    }
+}
+
+#endif /* OS_CFG_PT */
@@ -0,0 +1,66 @@
+/*
+ * =====================================================================
+ *  Signal buffer (seqlock) – hiện thực
+ *
+ *  1 bản sao:
+ *    write: seq++ (lẻ) → DMB → chép → DMB → seq++ (chẵn)
+ *    read : s1 = seq (chẵn) → DMB → chép → DMB → s2 = seq; lặp nếu s1 != s2
+ *
+ *  2 bản sao (latch):
+ *    write: seq++ → DMB → chép bản [0] → DMB → seq++ → DMB → chép bản [1]
+ *    read : s = seq → DMB → chép bản [s & 1] → DMB → lặp nếu seq != s
+ *    (seq lẻ: writer đang sửa bản [0] → reader đọc bản [1] và ngược lại)
+ * =====================================================================
+ */
+
+#include "os_signal.h"
+#include "stm32f10x.h"      /* __DMB */
+
+#include <stdint.h>
+
+static inline void sig_copy(uint8_t *dst, const uint8_t *src, uint16_t n)
+{
+    while (n--) {
+        *dst++ = *src++;
+    }
+}
+
+void SignalWrite(OsSignal_t *s, const void *src)
+{
+    uint8_t *b = (uint8_t *)s->buf;
+    uint32_t seq = s->seq;
+
+    s->seq = seq + 1u;
+    __DMB();
+    sig_copy(b, (const uint8_t *)src, s->size);
+    __DMB();
+    s->seq = seq + 2u;
+
+    if (s->dbuf) {
+        __DMB();
+        sig_copy(b + s->size, (const uint8_t *)src, s->size);
+    }
+}
+
+bool SignalTryRead(const OsSignal_t *s, void *dst)
+{
+    const uint8_t *b = (const uint8_t *)s->buf;
+    uint32_t seq = s->seq;
+
+    if (s->dbuf) {
+        b += (seq & 1u) * s->size;
+    } else if (seq & 1u) {
+        return false;                   /* writer đang ghi */
+    }
+    __DMB();
+    sig_copy((uint8_t *)dst, b, s->size);
+    __DMB();
+    return (s->seq == seq);
+}
+
+void SignalRead(const OsSignal_t *s, void *dst)
+{
+    while (!SignalTryRead(s, dst)) {
+        /* bị rách → đọc lại */
+    }
+}
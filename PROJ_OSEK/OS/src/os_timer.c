@@ -0,0 +1,68 @@
+/*
+ * =====================================================================
+ *  Task timer của kernel – chạy callback Alarm / Schedule Table
+ *  - ISR tick KHÔNG gọi callback: chỉ ghi con trỏ hàm vào slot, OR bit
+ *    pending (LDREX/STREX, không tắt IRQ) rồi SetEvent cho TASK_TIMER.
+ *    → thời gian ISR không phụ thuộc callback của ứng dụng.
+ *  - TASK_TIMER lấy từng word bitmap bằng 1 lệnh xchg, chạy callback theo thứ tự
+ *    slot (alarm trước, expiry point sau) ở ưu tiên OS_TIMER_TASK_PRIO.
+ *  - Timer READY trong tick → kernel đẩy task đang chạy ra ở cuối ISR
+ *    tick (timer_preempt, os_kernel.c): callback chạy ngay sau ISR.
+ *  - Slot đến hạn lại khi còn pending → gộp làm 1 lần, đếm overrun.
+ * =====================================================================
+ */
+
+#include "os_internal.h"
+#include "os_atomic.h"
+#include "stm32f10x.h"
+
+#include <stdint.h>
+
+#if (OS_CFG_TIMER_TASK)
+
+#define TIMER_EV_PENDING    1u
+#define TIMER_WORDS         ((OS_TIMER_SLOTS + 31u) / 32u)
+
+static void (*volatile timer_fn[OS_TIMER_SLOTS])(void);
+static volatile uint32_t timer_pending[TIMER_WORDS];   /* bitmap slot */
+static volatile uint32_t timer_overrun;    /* chỉ ISR tick ghi */
+
+void os_timer_defer(uint8_t slot, void (*fn)(void))
+{
+    uint32_t bit = 1u << (slot & 31u);
+
+    timer_fn[slot] = fn;
+    __DMB();                        /* fn phải thấy trước bit pending */
+    if (os_atomic_or32(&timer_pending[slot >> 5], bit) & bit) {
+        timer_overrun++;            /* lần trước chưa chạy → gộp */
+        return;
+    }
+    SetEvent(TASK_TIMER, TIMER_EV_PENDING);
+}
+
+void os_timer_task(void *arg)
+{
+    (void)arg;
+
+    for (;;) {
+        WaitEvent(TIMER_EV_PENDING);
+        ClearEvent(TIMER_EV_PENDING);
+
+        for (uint32_t w = 0u; w < TIMER_WORDS; ++w) {
+            uint32_t pend = os_atomic_xchg32(&timer_pending[w], 0u);
+            __DMB();
+            while (pend != 0u) {
+                uint32_t slot = (w << 5) + __CLZ(__RBIT(pend));   /* bit thấp nhất */
+                pend &= pend - 1u;
+                timer_fn[slot]();
+            }
+        }
+    }
+}
+
+uint32_t GetTimerOverrun(void)
+{
+    return timer_overrun;
+}
+
+#endif /* OS_CFG_TIMER_TASK */
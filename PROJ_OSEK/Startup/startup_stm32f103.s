@@ -12,7 +12,6 @@
     .section .isr_vector, "a", %progbits
     .align  2
     .type   g_pfnVectors, %object
-    .size   g_pfnVectors, .-g_pfnVectors
 
 g_pfnVectors:
     .word   _estack                 /* 0x00: Initial Stack Pointer */
@@ -32,6 +31,52 @@ g_pfnVectors:
     .word   PendSV_Handler          /* 0x38: PendSV Handler */
     .word   SysTick_Handler         /* 0x3C: SysTick Handler */
 
+    /* ----- IRQ ngoại vi (STM32F10x medium-density, theo RM0008) ----- */
+    .word   WWDG_IRQHandler             /* 0x40: IRQ0  */
+    .word   PVD_IRQHandler              /* 0x44: IRQ1  */
+    .word   TAMPER_IRQHandler           /* 0x48: IRQ2  */
+    .word   RTC_IRQHandler              /* 0x4C: IRQ3  */
+    .word   FLASH_IRQHandler            /* 0x50: IRQ4  */
+    .word   RCC_IRQHandler              /* 0x54: IRQ5  */
+    .word   EXTI0_IRQHandler            /* 0x58: IRQ6  */
+    .word   EXTI1_IRQHandler            /* 0x5C: IRQ7  */
+    .word   EXTI2_IRQHandler            /* 0x60: IRQ8  */
+    .word   EXTI3_IRQHandler            /* 0x64: IRQ9  */
+    .word   EXTI4_IRQHandler            /* 0x68: IRQ10 */
+    .word   DMA1_Channel1_IRQHandler    /* 0x6C: IRQ11 */
+    .word   DMA1_Channel2_IRQHandler    /* 0x70: IRQ12 */
+    .word   DMA1_Channel3_IRQHandler    /* 0x74: IRQ13 */
+    .word   DMA1_Channel4_IRQHandler    /* 0x78: IRQ14 */
+    .word   DMA1_Channel5_IRQHandler    /* 0x7C: IRQ15 */
+    .word   DMA1_Channel6_IRQHandler    /* 0x80: IRQ16 */
+    .word   DMA1_Channel7_IRQHandler    /* 0x84: IRQ17 */
+    .word   ADC1_2_IRQHandler           /* 0x88: IRQ18 */
+    .word   USB_HP_CAN1_TX_IRQHandler   /* 0x8C: IRQ19 */
+    .word   USB_LP_CAN1_RX0_IRQHandler  /* 0x90: IRQ20 */
+    .word   CAN1_RX1_IRQHandler         /* 0x94: IRQ21 */
+    .word   CAN1_SCE_IRQHandler         /* 0x98: IRQ22 */
+    .word   EXTI9_5_IRQHandler          /* 0x9C: IRQ23 */
+    .word   TIM1_BRK_IRQHandler         /* 0xA0: IRQ24 */
+    .word   TIM1_UP_IRQHandler          /* 0xA4: IRQ25 */
+    .word   TIM1_TRG_COM_IRQHandler     /* 0xA8: IRQ26 */
+    .word   TIM1_CC_IRQHandler          /* 0xAC: IRQ27 */
+    .word   TIM2_IRQHandler             /* 0xB0: IRQ28 */
+    .word   TIM3_IRQHandler             /* 0xB4: IRQ29 */
+    .word   TIM4_IRQHandler             /* 0xB8: IRQ30 */
+    .word   I2C1_EV_IRQHandler          /* 0xBC: IRQ31 */
+    .word   I2C1_ER_IRQHandler          /* 0xC0: IRQ32 */
+    .word   I2C2_EV_IRQHandler          /* 0xC4: IRQ33 */
+    .word   I2C2_ER_IRQHandler          /* 0xC8: IRQ34 */
+    .word   SPI1_IRQHandler             /* 0xCC: IRQ35 */
+    .word   SPI2_IRQHandler             /* 0xD0: IRQ36 */
+    .word   USART1_IRQHandler           /* 0xD4: IRQ37 */
+    .word   USART2_IRQHandler           /* 0xD8: IRQ38 */
+    .word   USART3_IRQHandler           /* 0xDC: IRQ39 */
+    .word   EXTI15_10_IRQHandler        /* 0xE0: IRQ40 */
+    .word   RTCAlarm_IRQHandler         /* 0xE4: IRQ41 */
+    .word   USBWakeUp_IRQHandler        /* 0xE8: IRQ42 */
+    .size   g_pfnVectors, .-g_pfnVectors
+
 /* ========= Default Handler (vòng lặp vô hạn) ========= */
     .section .text.Default_Handler, "ax", %progbits
     .weak   Default_Handler
@@ -68,6 +113,57 @@ Default_Handler:
     .weak   SysTick_Handler
     .set    SysTick_Handler, Default_Handler
 
+/* IRQ ngoại vi: mặc định về Default_Handler, ứng dụng khai báo bằng
+ * ISR1()/ISR2() (OS/inc/os_isr.h) để ghi đè */
+    .macro  IRQ_WEAK name
+    .weak   \name
+    .thumb_set \name, Default_Handler
+    .endm
+
+    IRQ_WEAK WWDG_IRQHandler
+    IRQ_WEAK PVD_IRQHandler
+    IRQ_WEAK TAMPER_IRQHandler
+    IRQ_WEAK RTC_IRQHandler
+    IRQ_WEAK FLASH_IRQHandler
+    IRQ_WEAK RCC_IRQHandler
+    IRQ_WEAK EXTI0_IRQHandler
+    IRQ_WEAK EXTI1_IRQHandler
+    IRQ_WEAK EXTI2_IRQHandler
+    IRQ_WEAK EXTI3_IRQHandler
+    IRQ_WEAK EXTI4_IRQHandler
+    IRQ_WEAK DMA1_Channel1_IRQHandler
+    IRQ_WEAK DMA1_Channel2_IRQHandler
+    IRQ_WEAK DMA1_Channel3_IRQHandler
+    IRQ_WEAK DMA1_Channel4_IRQHandler
+    IRQ_WEAK DMA1_Channel5_IRQHandler
+    IRQ_WEAK DMA1_Channel6_IRQHandler
+    IRQ_WEAK DMA1_Channel7_IRQHandler
+    IRQ_WEAK ADC1_2_IRQHandler
+    IRQ_WEAK USB_HP_CAN1_TX_IRQHandler
+    IRQ_WEAK USB_LP_CAN1_RX0_IRQHandler
+    IRQ_WEAK CAN1_RX1_IRQHandler
+    IRQ_WEAK CAN1_SCE_IRQHandler
+    IRQ_WEAK EXTI9_5_IRQHandler
+    IRQ_WEAK TIM1_BRK_IRQHandler
+    IRQ_WEAK TIM1_UP_IRQHandler
+    IRQ_WEAK TIM1_TRG_COM_IRQHandler
+    IRQ_WEAK TIM1_CC_IRQHandler
+    IRQ_WEAK TIM2_IRQHandler
+    IRQ_WEAK TIM3_IRQHandler
+    IRQ_WEAK TIM4_IRQHandler
+    IRQ_WEAK I2C1_EV_IRQHandler
+    IRQ_WEAK I2C1_ER_IRQHandler
+    IRQ_WEAK I2C2_EV_IRQHandler
+    IRQ_WEAK I2C2_ER_IRQHandler
+    IRQ_WEAK SPI1_IRQHandler
+    IRQ_WEAK SPI2_IRQHandler
+    IRQ_WEAK USART1_IRQHandler
+    IRQ_WEAK USART2_IRQHandler
+    IRQ_WEAK USART3_IRQHandler
+    IRQ_WEAK EXTI15_10_IRQHandler
+    IRQ_WEAK RTCAlarm_IRQHandler
+    IRQ_WEAK USBWakeUp_IRQHandler
+
 /* ========= Reset Handler ========= */
     .section .text.Reset_Handler, "ax", %progbits
     .weak   Reset_Handler
@@ -0,0 +1,510 @@
+/*
+ * =========================================================
+ *  Benchmark trên target (make BENCH=1)
+ *  - Task_Init gọi Bench_Run(): đo các API ngay trong Task_Init.
+ *  - Task_C đóng vai pong cho các phép đo round-trip Task ⇄ Task.
+ *  - TASK_BENCH0..: task riêng của benchmark (Bench_Task), vai trò theo
+ *    pha s_bench_phase; hẹn với Task_Init qua bench_arrive/bench_join.
+ *  - ISR producer: TIM3 one-pulse (ISR2) – bắn khi Task_Init đã chặn.
+ * =========================================================
+ */
+#include "App_Bench.h"
+
+#ifdef APP_BENCH
+
+#include "os_kernel.h"
+#include "os_ioc.h"
+#include "os_pool.h"
+#include "os_msgq.h"
+#include "os_log.h"
+#include "os_port.h"
+#include "os_pt.h"
+#include "os_isr.h"
+#include "stm32f10x.h"
+
+#include <stddef.h>
+
+#define BENCH_ROUNDS    32u
+
+OsPerf_t g_bench[BENCH_COUNT];
+
+static void bench_report(uint32_t first)
+{
+    for (uint32_t i = first; i < BENCH_COUNT; ++i) {
+        const OsPerf_t *p = &g_bench[i];
+        if (p->count == 0u)
+            continue;
+        OS_LOG("[BENCH] #%u min=%u avg=%u max=%u n=%u", i, p->min, os_perf_avg(p), p->max, p->count);
+    }
+}
+
+/* ---------------- Task benchmark ---------------- */
+
+#define BENCH_EV_DONE   0x08000000u     /* task bench → Task_Init: đủ n task tới điểm hẹn */
+#define BENCH_EV_QUIT   0x02000000u     /* Task_Init → task bench: kết thúc pha */
+
+enum {
+    BENCH_PH_IOC_RX = 0u,               /* TASK_BENCH0 nhận IOC_BENCH_RX */
+    BENCH_PH_LISTEN,                    /* listener của TASKGROUP_BENCH8/16 */
+    BENCH_PH_CHAIN,                     /* TASK_BENCH0 → 1 → … → 5 bằng ChainTask */
+};
+
+static volatile uint8_t s_bench_phase;
+static volatile uint8_t s_bench_left;   /* số task bench chưa tới điểm hẹn */
+
+/* Task bench tới điểm hẹn; task cuối đánh thức Task_Init. Không cần
+ * khoá: task bench cùng ưu tiên, run-to-completion (benchmark tắt RR). */
+static void bench_arrive(void)
+{
+    if (--s_bench_left == 0u) {
+        SetEvent(TASK_INIT, BENCH_EV_DONE);
+    }
+}
+
+/* Task_Init chặn tới khi n task bench gọi bench_arrive(). Task bench ưu
+ * tiên thấp hơn Init → chỉ chạy sau WaitEvent ở đây, đặt n trước là đủ. */
+static void bench_join(uint8_t n)
+{
+    s_bench_left = n;
+    WaitEvent(BENCH_EV_DONE);
+    ClearEvent(BENCH_EV_DONE);
+}
+
+/* ---------------- IOC ---------------- */
+
+static volatile uint8_t s_ioc_bench;    /* BENCH_IOC_ISR2TASK / BENCH_IOC_TASK2TASK */
+
+/* TIM3 one-pulse 1 MHz: ngắt update sau BENCH_ISR_DELAY_US, đủ để
+ * Task_Init vào WaitEvent → ISR đến khi IDLE chạy */
+#define BENCH_ISR_DELAY_US  50u
+
+static void bench_tim3_init(void)
+{
+    RCC->APB1ENR |= RCC_APB1ENR_TIM3EN;
+    TIM3->CR1  = TIM_CR1_OPM;
+    TIM3->PSC  = (uint16_t)((SystemCoreClock / 1000000u) - 1u);
+    TIM3->ARR  = BENCH_ISR_DELAY_US;
+    TIM3->EGR  = TIM_EGR_UG;            /* nạp PSC ngay */
+    TIM3->SR   = 0u;
+    TIM3->DIER = TIM_DIER_UIE;
+
+    NVIC_SetPriority(TIM3_IRQn, 0xFEu); /* cùng mức SysTick */
+    NVIC_EnableIRQ(TIM3_IRQn);
+}
+
+static void bench_tim3_fire(void)
+{
+    TIM3->CNT = 0u;
+    TIM3->CR1 = TIM_CR1_OPM | TIM_CR1_CEN;
+}
+
+/* ISR producer: đóng dấu thời gian rồi gửi; kênh SetEvent cho TASK_BENCH0 */
+ISR2(TIM3_IRQHandler, ISR_BENCH)
+{
+    uint32_t stamp;
+
+    TIM3->SR = (uint16_t)~TIM_SR_UIF;
+    stamp = os_perf_now();
+    (void)IocSend(IOC_BENCH_RX, &stamp);
+}
+
+/* Bên nhận (TASK_BENCH0): đóng dấu ở lệnh đầu tiên sau khi WaitEvent trả
+ * về → độ trễ = IocSend (+ SetEvent của kênh) → dispatch → tới đây */
+static void bench_ioc_rx(void)
+{
+    EventMaskType ev;
+    uint32_t t1, v;
+
+    for (;;) {
+        bench_arrive();                 /* sẵn sàng cho vòng kế */
+        WaitEvent(EVENT_BENCH_IOC | BENCH_EV_QUIT);
+        t1 = os_perf_now();
+        (void)GetEvent(TASK_BENCH0, &ev);
+        ClearEvent(ev);
+        while (IocReceive(IOC_BENCH_RX, &v) == IOC_E_OK) {
+            os_perf_add(&g_bench[s_ioc_bench], t1 - v);
+        }
+        if (ev & BENCH_EV_QUIT)
+            return;
+    }
+}
+
+static void bench_ioc(void)
+{
+    uint32_t v = 0u, t0;
+    uint8_t blk[16] = { 0 };
+
+    /* 1) Chi phí từng thao tác (throughput = f_CPU / avg) */
+    for (uint32_t i = 0u; i < BENCH_ROUNDS; ++i) {
+        t0 = os_perf_now();
+        (void)IocSend(IOC_BENCH_Q, &i);
+        os_perf_add(&g_bench[BENCH_IOC_SEND], os_perf_now() - t0);
+    }
+    for (uint32_t i = 0u; i < BENCH_ROUNDS; ++i) {
+        t0 = os_perf_now();
+        (void)IocReceive(IOC_BENCH_Q, &v);
+        os_perf_add(&g_bench[BENCH_IOC_RECV], os_perf_now() - t0);
+    }
+    for (uint32_t i = 0u; i < BENCH_ROUNDS; ++i) {
+        blk[0] = (uint8_t)i;
+        t0 = os_perf_now();
+        (void)IocWrite(IOC_BENCH_LIB, blk);
+        os_perf_add(&g_bench[BENCH_IOC_WRITE], os_perf_now() - t0);
+        t0 = os_perf_now();
+        (void)IocRead(IOC_BENCH_LIB, blk);
+        os_perf_add(&g_bench[BENCH_IOC_READ], os_perf_now() - t0);
+    }
+
+    /* 2) ISR → Task: TIM3 bắn khi Init đã chặn (IDLE chạy) */
+    s_bench_phase = BENCH_PH_IOC_RX;
+    s_ioc_bench   = BENCH_IOC_ISR2TASK;
+    bench_tim3_init();
+    ActivateTask(TASK_BENCH0);
+    bench_join(1u);                     /* bên nhận đang chờ */
+    for (uint32_t i = 0u; i < BENCH_ROUNDS; ++i) {
+        bench_tim3_fire();
+        bench_join(1u);
+    }
+
+    /* 3) Task → Task: Init gửi rồi chặn ngay; bên nhận chạy kế tiếp */
+    s_ioc_bench = BENCH_IOC_TASK2TASK;
+    for (uint32_t i = 0u; i < BENCH_ROUNDS; ++i) {
+        v = os_perf_now();
+        (void)IocSend(IOC_BENCH_RX, &v);
+        bench_join(1u);
+    }
+    SetEvent(TASK_BENCH0, BENCH_EV_QUIT);
+    bench_join(1u);                     /* TASK_BENCH0 đã DORMANT */
+}
+
+/* ---------------- Pool ---------------- */
+static void bench_pool(void)
+{
+    void *blk[16];
+    uint32_t n = 0u, t0;
+
+    while (n < 16u) {
+        t0 = os_perf_now();
+        blk[n] = PoolAlloc(POOL_16);
+        os_perf_add(&g_bench[BENCH_POOL_ALLOC], os_perf_now() - t0);
+        if (blk[n] == NULL)
+            break;
+        n++;
+    }
+    while (n-- > 0u) {
+        t0 = os_perf_now();
+        PoolFree(blk[n]);
+        os_perf_add(&g_bench[BENCH_POOL_FREE], os_perf_now() - t0);
+    }
+}
+
+/* ---------------- Khung stack khi ActivateTask ---------------- */
+
+static void bench_dummy_entry(void *arg) { (void)arg; }
+
+static void bench_frame(void)
+{
+    static uint32_t stk[32];
+    uint32_t *frame = os_task_stack_init(bench_dummy_entry, NULL, &stk[32]);
+    uint32_t t0;
+
+    for (uint32_t i = 0u; i < BENCH_ROUNDS; ++i) {
+        t0 = os_perf_now();
+        frame = os_task_stack_init(bench_dummy_entry, NULL, &stk[32]);
+        os_perf_add(&g_bench[BENCH_FRAME_INIT], os_perf_now() - t0);
+
+        t0 = os_perf_now();
+        frame = os_task_frame_rearm(frame, bench_dummy_entry, NULL);
+        os_perf_add(&g_bench[BENCH_FRAME_REARM], os_perf_now() - t0);
+    }
+}
+
+/* ---------------- Context switch ---------------- */
+
+/* Ping-pong bằng event: mỗi vòng = 2 lần chặn → PendSV. So sánh giữa
+ * các phiên bản PendSV/os_trigger_pendsv (đơn vị: chu kỳ / 2 switch).
+ * Chi phí hook: so sánh make BENCH=1 với make BENCH=1 HOOKS=1. */
+#define BENCH_EV_PING   0x10000000u
+#define BENCH_EV_PONG   0x10000000u
+
+#if (OS_CFG_HOOKS)
+/* Back-end tối thiểu: đếm số lần vào/ra task (đọc bằng debugger) */
+static volatile uint32_t s_hook_pre;
+static volatile uint32_t s_hook_post;
+
+void PreTaskHook(void)  { s_hook_pre++; }
+void PostTaskHook(void) { s_hook_post++; }
+#endif
+
+static void bench_ctxsw(void)
+{
+    uint32_t t0;
+    for (uint32_t i = 0u; i < BENCH_ROUNDS; ++i) {
+        t0 = os_perf_now();
+        SetEvent(TASK_C, BENCH_EV_PING);
+        WaitEvent(BENCH_EV_PONG);
+        os_perf_add(&g_bench[BENCH_CTXSW_RTT], os_perf_now() - t0);
+        ClearEvent(BENCH_EV_PONG);
+    }
+}
+
+/* ---------------- Coroutine ---------------- */
+#if (OS_CFG_PT)
+
+/* Cùng ping-pong như bench_ctxsw nhưng đầu kia là coroutine (chạy trên
+ * stack của TASK_PT): BENCH_PT_RTT - BENCH_CTXSW_RTT = chi phí lớp
+ * coroutine (PtSetEvent + quét pt_ready + nhảy tới điểm chờ). */
+uint8_t Bench_PtPong(OsPt_t *pt)
+{
+    PT_BEGIN(pt);
+    for (;;) {
+        PT_WAIT_EVENT(pt, BENCH_EV_PING);
+        PtClearEvent(pt, BENCH_EV_PING);
+        SetEvent(TASK_INIT, BENCH_EV_PONG);
+    }
+    PT_END(pt);
+}
+
+static void bench_pt(void)
+{
+    uint32_t t0;
+    for (uint32_t i = 0u; i < BENCH_ROUNDS; ++i) {
+        t0 = os_perf_now();
+        (void)PtSetEvent(PT_BENCH, BENCH_EV_PING);
+        WaitEvent(BENCH_EV_PONG);
+        os_perf_add(&g_bench[BENCH_PT_RTT], os_perf_now() - t0);
+        ClearEvent(BENCH_EV_PONG);
+    }
+}
+#endif
+
+/* ---------------- MsgQ ---------------- */
+
+/* Round-trip: Task_Init gửi yêu cầu rồi chặn chờ trả lời; Task_C (pong)
+ * nhận và trả lời ngay. Trả lời được hand-off thẳng vào bộ đệm của Init. */
+static void bench_msgq(void)
+{
+    uint32_t v, t0;
+    for (uint32_t i = 0u; i < BENCH_ROUNDS; ++i) {
+        t0 = os_perf_now();
+        (void)MsgQSend(MSGQ_BENCH_REQ, &t0, OS_WAIT_FOREVER);
+        if (MsgQReceive(MSGQ_BENCH_RSP, &v, 100u) == MSGQ_E_OK) {
+            os_perf_add(&g_bench[BENCH_MSGQ_RTT], os_perf_now() - t0);
+        }
+    }
+}
+
+/* ---------------- Event group ---------------- */
+
+/* n listener (TASK_BENCH0..n-1) cùng chờ BENCH_EV; mỗi vòng đo 1 lần
+ * SetEventGroup so với n lần SetEvent – cả hai đều đánh thức đủ n task. */
+#define BENCH_EV    0x40000000u
+
+static void bench_listener(uint8_t idx)
+{
+    EventMaskType ev;
+
+    for (;;) {
+        bench_arrive();                 /* đã xử lý xong, sắp chờ lại */
+        WaitEvent(BENCH_EV | BENCH_EV_QUIT);
+        (void)GetEvent((TaskType)(TASK_BENCH0 + idx), &ev);
+        ClearEvent(ev);
+        if (ev & BENCH_EV_QUIT)
+            return;
+    }
+}
+
+static void bench_evgroup(uint8_t n, uint8_t gid, uint32_t id_group, uint32_t id_single)
+{
+    uint32_t t0;
+
+    s_bench_phase = BENCH_PH_LISTEN;
+    for (uint8_t k = 0u; k < n; ++k) {
+        ActivateTask((TaskType)(TASK_BENCH0 + k));
+    }
+    bench_join(n);                      /* mọi listener đang chờ */
+
+    for (uint32_t i = 0u; i < BENCH_ROUNDS; ++i) {
+        t0 = os_perf_now();
+        SetEventGroup(gid, BENCH_EV);
+        os_perf_add(&g_bench[id_group], os_perf_now() - t0);
+        bench_join(n);
+
+        t0 = os_perf_now();
+        for (uint8_t k = 0u; k < n; ++k) {
+            SetEvent((TaskType)(TASK_BENCH0 + k), BENCH_EV);
+        }
+        os_perf_add(&g_bench[id_single], os_perf_now() - t0);
+        bench_join(n);
+    }
+    SetEventGroup(gid, BENCH_EV_QUIT);
+    bench_join(n);                      /* mọi listener đã DORMANT */
+}
+
+/* ---------------- ISR tick ---------------- */
+
+/* Callback "chậm" ~20 µs (1440 chu kỳ @72 MHz). So sánh max của
+ * BENCH_TICK_ISR giữa OS_CFG_TIMER_TASK=0 (gọi trong ISR) và =1 (hoãn).
+ * Task_Init bận suốt phép đo → timer phải đẩy Init ra mỗi tick, nếu
+ * không mọi tick sau lần đầu chỉ là overrun (không chạy callback). */
+#define BENCH_SLOW_CYCLES   1440u
+#define BENCH_TICKS         64u
+
+static volatile uint32_t s_slow_runs;
+
+void Bench_SlowCallback(void)
+{
+    uint32_t t0 = os_perf_now();
+    os_perf_add(&g_bench[BENCH_TICK_CB], t0 - g_os_tick_t0);
+    s_slow_runs++;
+    while ((os_perf_now() - t0) < BENCH_SLOW_CYCLES) {
+        __NOP();
+    }
+}
+
+static void bench_tick_isr(void)
+{
+#if (OS_CFG_TIMER_TASK)
+    uint32_t ovr = GetTimerOverrun();
+#endif
+    s_slow_runs = 0u;
+    os_perf_reset(&g_os_tick_perf);
+    SetRelAlarm(1u, 1u, 1u);
+    while (s_slow_runs < BENCH_TICKS) {     /* callback chạy đủ BENCH_TICKS tick */
+        __NOP();
+    }
+    SetRelAlarm(1u, 1u, 0u);    /* chu kỳ 0 → kích 1 lần nữa rồi tắt */
+    g_bench[BENCH_TICK_ISR] = g_os_tick_perf;
+#if (OS_CFG_TIMER_TASK)
+    OS_LOG("[BENCH] tick: callback=%u tick=%u overrun=%u",
+           s_slow_runs, g_os_tick_perf.count, GetTimerOverrun() - ovr);
+#endif
+}
+
+/* n alarm (AID 2..) cùng hết hạn trong 1 tick; lấy max của cửa sổ đo.
+ * So sánh OS_CFG_DEFERRED_DISPATCH=0 / =1. */
+static void bench_tick_expiries(void)
+{
+    static const uint8_t n_exp[3] = { 1u, 8u, 32u };
+
+    for (uint32_t k = 0u; k < 3u; ++k) {
+        for (uint32_t r = 0u; r < 8u; ++r) {
+            /* đồng bộ với biên tick → mọi alarm cùng 1 mốc hết hạn */
+            uint32_t c = g_os_tick_perf.count;
+            while (g_os_tick_perf.count == c) {
+                __NOP();
+            }
+            for (uint8_t a = 0u; a < n_exp[k]; ++a) {
+                SetRelAlarm((uint8_t)(2u + a), 3u, 0u);
+            }
+            os_perf_reset(&g_os_tick_perf);
+            while (g_os_tick_perf.count < 6u) {
+                __NOP();
+            }
+            os_perf_add(&g_bench[BENCH_TICK_EXP1 + k], g_os_tick_perf.max);
+        }
+    }
+}
+
+/* ---------------- ChainTask ---------------- */
+
+/* Chuỗi 5 chặng qua 6 task khác nhau: TASK_BENCH0 → … → TASK_BENCH5,
+ * Task_Init chờ suốt chuỗi. Mỗi chặng đo từ ngay trước ChainTask tới
+ * đầu entry của task kế tiếp. */
+#define BENCH_CHAIN_STAGES  5u
+
+static uint32_t s_chain_t0;
+static uint32_t s_chain_sum;
+
+static void bench_chain_stage(uint8_t idx)
+{
+    if (idx != 0u) {
+        uint32_t hop = os_perf_now() - s_chain_t0;
+        os_perf_add(&g_bench[BENCH_CHAIN_HOP], hop);
+        s_chain_sum += hop;
+    }
+    if (idx == BENCH_CHAIN_STAGES) {
+        os_perf_add(&g_bench[BENCH_CHAIN5], s_chain_sum);
+        return;                         /* chặng cuối: về điểm hẹn */
+    }
+    s_chain_t0 = os_perf_now();
+    ChainTask((TaskType)(TASK_BENCH0 + idx + 1u));
+}
+
+static void bench_chain(void)
+{
+    s_bench_phase = BENCH_PH_CHAIN;
+    for (uint32_t i = 0u; i < BENCH_ROUNDS; ++i) {
+        s_chain_sum = 0u;
+        ActivateTask(TASK_BENCH0);
+        bench_join(1u);
+    }
+}
+
+/* ---------------- Pong của Task_C ---------------- */
+
+void Bench_TaskC(void)
+{
+    uint32_t v;
+
+    /* Pong cho bench_ctxsw() */
+    for (uint32_t i = 0u; i < BENCH_ROUNDS; ++i) {
+        WaitEvent(BENCH_EV_PING);
+        ClearEvent(BENCH_EV_PING);
+        SetEvent(TASK_INIT, BENCH_EV_PONG);
+    }
+
+    /* Pong cho bench_msgq() */
+    for (uint32_t i = 0u; i < BENCH_ROUNDS; ++i) {
+        (void)MsgQReceive(MSGQ_BENCH_REQ, &v, OS_WAIT_FOREVER);
+        (void)MsgQSend(MSGQ_BENCH_RSP, &v, OS_WAIT_FOREVER);
+    }
+}
+
+void Bench_Run(void)
+{
+    for (uint32_t i = 0u; i < BENCH_COUNT; ++i) {
+        os_perf_reset(&g_bench[i]);
+    }
+    os_perf_reset(&g_os_sched_perf);
+    bench_pool();
+    bench_frame();
+    bench_evgroup(8u,  TASKGROUP_BENCH8,  BENCH_EVGROUP8,  BENCH_EVSINGLE8);
+    bench_evgroup(16u, TASKGROUP_BENCH16, BENCH_EVGROUP16, BENCH_EVSINGLE16);
+    bench_tick_isr();
+    bench_tick_expiries();
+#if (OS_CFG_PT)
+    bench_pt();
+#endif
+    bench_ioc();
+    ActivateTask(TASK_C);   /* pong cho ctxsw / msgq */
+    bench_ctxsw();
+    bench_msgq();
+    bench_chain();
+    /* mọi lần schedule() từ đầu Bench_Run (so sánh make BENCH=1 EDF=1) */
+    g_bench[BENCH_SCHED] = g_os_sched_perf;
+    bench_report(0u);
+}
+
+void Bench_Task(void *arg)
+{
+    uint8_t idx = (uint8_t)(uintptr_t)arg;
+
+    switch (s_bench_phase) {
+    case BENCH_PH_IOC_RX:
+        bench_ioc_rx();
+        break;
+    case BENCH_PH_LISTEN:
+        bench_listener(idx);
+        break;
+    case BENCH_PH_CHAIN:
+        bench_chain_stage(idx);         /* chỉ chặng cuối trả về */
+        break;
+    default:
+        break;
+    }
+    bench_arrive();         /* kết thúc pha */
+    TerminateTask();
+}
+
+#endif /* APP_BENCH */
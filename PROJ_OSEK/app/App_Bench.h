@@ -0,0 +1,47 @@
+#pragma once
+/*
+ * =========================================================
+ *  Benchmark trên target (build: make BENCH=1 → -DAPP_BENCH)
+ *  - Kết quả: g_bench[] (đọc bằng debugger) + OS_LOG "[BENCH]".
+ *  - Đơn vị: chu kỳ CPU (DWT->CYCCNT, 72 MHz).
+ * =========================================================
+ */
+#include "os_perf.h"
+
+typedef enum {
+    BENCH_IOC_SEND = 0,     /* IocSend (queued, 4 byte)                  */
+    BENCH_IOC_RECV,         /* IocReceive (queued, 4 byte)               */
+    BENCH_IOC_WRITE,        /* IocWrite (last-is-best, 16 byte)          */
+    BENCH_IOC_READ,         /* IocRead (last-is-best, 16 byte)           */
+    BENCH_IOC_ISR2TASK,     /* TIM3 ISR: IocSend → lệnh đầu của TASK_BENCH0 sau WaitEvent */
+    BENCH_IOC_TASK2TASK,    /* Task_Init: IocSend + WaitEvent → như trên */
+    BENCH_POOL_ALLOC,       /* PoolAlloc(POOL_16)                        */
+    BENCH_POOL_FREE,        /* PoolFree                                  */
+    BENCH_MSGQ_RTT,         /* Task_Init → Task_C → Task_Init (MsgQ)     */
+    BENCH_EVGROUP8,         /* SetEventGroup: đánh thức 8 listener       */
+    BENCH_EVGROUP16,        /* ... 16 listener                           */
+    BENCH_EVSINGLE8,        /* 8 × SetEvent cho cùng 8 listener          */
+    BENCH_EVSINGLE16,       /* 16 × SetEvent cho cùng 16 listener        */
+    BENCH_TICK_ISR,         /* os_on_tick() khi có callback chậm mỗi tick */
+    BENCH_TICK_CB,          /* vào os_on_tick() → lệnh đầu của callback chậm */
+    BENCH_TICK_EXP1,        /* max os_on_tick(): 1 alarm hết hạn cùng tick  */
+    BENCH_TICK_EXP8,        /* ... 8 alarm                                */
+    BENCH_TICK_EXP32,       /* ... 32 alarm                               */
+    BENCH_FRAME_INIT,       /* os_task_stack_init: dựng đủ 16 word       */
+    BENCH_FRAME_REARM,      /* os_task_frame_rearm: ghi lại 4 word       */
+    BENCH_CTXSW_RTT,        /* Init ⇄ Task_C qua SetEvent/WaitEvent: 2 lần đổi ngữ cảnh */
+    BENCH_CHAIN_HOP,        /* ChainTask → entry của task kế tiếp        */
+    BENCH_CHAIN5,           /* chuỗi 5 chặng ChainTask (tổng)            */
+    BENCH_SCHED,            /* schedule(): FIFO hoặc heap EDF (OS_CFG_EDF) */
+    BENCH_PT_RTT,           /* Init ⇄ coroutine PT_BENCH (so với BENCH_CTXSW_RTT) */
+    BENCH_COUNT
+} BenchId_e;
+
+#ifdef APP_BENCH
+extern OsPerf_t g_bench[BENCH_COUNT];
+
+void Bench_Run(void);       /* gọi trong Task_Init (trước TerminateTask) */
+void Bench_TaskC(void);     /* thân Task_C khi build benchmark: pong ctxsw / msgq */
+void Bench_SlowCallback(void); /* callback của AID 1 (SetUpAlarm) */
+void Bench_Task(void *arg);    /* thân chung của TASK_BENCH0.. (arg = chỉ số) */
+#endif
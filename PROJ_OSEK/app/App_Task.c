@@ -1,14 +1,86 @@
 #include "os_kernel.h"
+#include "os_log.h"
+#include "os_ioc.h"
+#include "os_signal.h"
+#include "os_isr.h"
+#include "os_pt.h"
+#include "App_Bench.h"
 #include "stm32f10x.h"
 #include "stm32f10x_rcc.h"
 #include "stm32f10x_gpio.h"
 #include "stm32f10x_usart.h"
 
 
-LedState g_mode;
-void SetMode_Normal(void)   { g_mode = MODE_NORMAL;}
-void SetMode_Warning(void)  { g_mode = MODE_WARNING;}
-void SetMode_Off(void)      { g_mode = MODE_OFF;}
+/* Chế độ xe: ghi từ callback (ISR/task), đọc bởi nhiều task.
+ * Dùng biến thể 2 bản sao để reader không bao giờ phải chờ writer. */
+OS_SIGNAL_DEFINE_DB(g_mode_sig, LedState);
+
+#if (OS_CFG_SCHTBL)
+/* Mỗi chế độ = 1 schedule table dựng sẵn (Setup_SchTbl). Đổi chế độ =
+ * NextSchedulTbl(): bảng mới vào đúng cuối chu kỳ bảng cũ, trong ISR tick */
+static const uint8_t mode_tbl[] = {
+    [MODE_NORMAL]  = SCHTBL_MODE_NORMAL,
+    [MODE_WARNING] = SCHTBL_MODE_WARNING,
+    [MODE_OFF]     = SCHTBL_MODE_OFF,
+};
+static uint8_t s_tbl_cur  = SCHTBL_MODE_NORMAL;    /* bảng đang chạy */
+static uint8_t s_tbl_next = SCHTBL_MODE_NORMAL;    /* bảng sẽ chạy (== cur: không chờ) */
+
+#endif
+
+static void SetMode(LedState m)
+{
+#if (OS_CFG_SCHTBL)
+    uint8_t to = mode_tbl[m];
+    ScheduleTableStatusType st;
+
+    /* bàn giao trước đó đã xảy ra → bảng kế thành bảng đang chạy */
+    GetSchedulTblStatus(s_tbl_cur, &st);
+    if (st == SCHEDULETABLE_STOPPED)
+        s_tbl_cur = s_tbl_next;
+
+    /* Kernel kiểm trạng thái + huỷ/thay bảng kế trong 1 vùng khoá
+     * (to == cur: huỷ lần đổi đang chờ) */
+    if (NextSchedulTbl(s_tbl_cur, to) != E_OK) {
+        /* cur vừa hết chu kỳ sau khi đọc trạng thái → nối sau bảng kế */
+        s_tbl_cur = s_tbl_next;
+        (void)NextSchedulTbl(s_tbl_cur, to);
+    }
+    s_tbl_next = to;
+#endif
+
+    SignalWrite(&g_mode_sig, &m);
+#if (OS_CFG_EVENTS)
+    SetEventGroup(TASKGROUP_MODE, EVENT_MODE_CHANGED);  /* báo mọi listener 1 lần */
+#endif
+}
+void SetMode_Normal(void)   { SetMode(MODE_NORMAL);}
+void SetMode_Warning(void)  { SetMode(MODE_WARNING);}
+void SetMode_Off(void)      { SetMode(MODE_OFF);}
+
+#if (OS_CFG_SCHTBL)
+/* EP của SCHTBL_MODE_OFF: giữ LED PC13 tắt */
+void Mode_LedOff(void)      { GPIO_WriteBit(GPIOC, GPIO_Pin_13, Bit_SET);}
+#endif
+
+#if (OS_CFG_ERROR_HOOK) && !defined(APP_BENCH)
+/* Lỗi API: ghi dịch vụ + tham số (build benchmark giữ hook rỗng của kernel) */
+void ErrorHook(StatusType error)
+{
+    OS_LOG("[ERR] svc=%u param=%u err=%u", OSErrorGetServiceId(), OSErrorGetParam1(), error);
+}
+#endif
+
+#if (OS_CFG_TIMING_PROT)
+/* Vi phạm thời gian: ghi log rồi để kernel phản ứng theo cấu hình */
+ProtectionReturnType ProtectionHook(StatusType fatal)
+{
+    TaskType id;
+    (void)GetTaskID(&id);
+    OS_LOG("[PROT] task=%u err=%u", id, fatal);
+    return OS_CFG_TP_REACTION;
+}
+#endif
 /* =========================================================
  * BSP: LED PC13 (BluePill – thường active-low)
  *  - Dùng SPL thay vì truy cập thanh ghi trực tiếp
@@ -110,6 +182,12 @@ static void uart1_send_string(const char *s)
     }
 }
 
+/* Đầu ra byte cho OS_LogDrain() – log nhị phân đi qua UART1 TX */
+static void uart1_log_put(uint8_t b)
+{
+    uart1_send_char((char)b);
+}
+
 /* =========================================================
  * Busy delay đơn giản (demo)
  *  - Thực tế OS nên có Alarm/Delay, ở đây giữ nguyên kiểu “ngủ nghèo”
@@ -125,63 +203,108 @@ static void busy_delay(volatile uint32_t loop)
  * =====                TASKS (dùng OS)                =====
  * ========================================================= */
 
-/* Task rỗi – vào WFI để tiết kiệm năng lượng khi không có READY */
+/* Task rỗi – xả log nhị phân (nếu có) rồi vào WFI khi không có READY */
 void Task_Idle(void *arg)
 {
     (void)arg;
 
     for (;;)
     {
+#if OS_CFG_LOG
+        (void)OS_LogDrain(uart1_log_put, 4u);
+#endif
         __WFI();
     }
 }
 void Task_C (void *arg){
+#ifdef APP_BENCH
+    Bench_TaskC();          /* build benchmark: Task_C là consumer của bench */
+    TerminateTask();
+#endif
     static uint8_t laststate = 1;
+    static uint32_t presses = 0;
     uint8_t now = GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_1);
 
     if(laststate == 1 && now ==0){
-        busy_delay(20);
+        /* Nhóm IRES_IO: không bị cắt lượt suốt 20 ms chống dội → tự
+         * nhường mỗi ms cho task ưu tiên cao hơn (Task_A nháy LED) */
+        for (uint8_t ms = 0u; ms < 20u; ++ms) {
+            busy_delay(1);
+            (void)Schedule();
+        }
         if(GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_1)==0){
-            SetEvent(TASK_B, EVENT_BUTTON_PRESSED);
+            /* Gửi qua IOC; kênh tự SetEvent(TASK_B, EVENT_BUTTON_PRESSED) */
+            presses++;
+            (void)IocSend(IOC_BUTTON, &presses);
+#if (OS_CFG_PT)
+            (void)PtSetEvent(PT_BUTTON_LED, EVENT_BUTTON_PRESSED);
+#endif
         }
     }
     laststate = now;
     TerminateTask();
 }
+/* Task_D: chẩn đoán nền – CRC-32 toàn bộ flash (bitwise, không bảng)
+ * - ~36 ms CPU mỗi lần @72 MHz, kích mỗi 1 s (alarm AID 3)
+ * - Cùng mức ưu tiên Task_B/Task_C: round-robin cắt lượt nên thăm dò
+ *   nút (Task_C, 50 ms) không phải chờ hết phép tính
+ */
+#define DIAG_FLASH_BYTES    (64u * 1024u)
+
+void Task_D(void *arg)
+{
+    (void)arg;
+    static uint32_t last_crc;
+    const uint8_t *p = (const uint8_t *)FLASH_BASE;
+    uint32_t crc = 0xFFFFFFFFu;
+
+    for (uint32_t i = 0u; i < DIAG_FLASH_BYTES; ++i) {
+        crc ^= p[i];
+        for (uint8_t b = 0u; b < 8u; ++b) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    crc = ~crc;
+    if (crc != last_crc) {
+        OS_LOG("[D] flash crc=0x%x", crc);
+        last_crc = crc;
+    }
+    TerminateTask();
+}
+
+/* Coroutine (TASK_PT): mỗi lần nhấn nút → LED A nháy 200 ms.
+ * Trạng thái nằm trong OsPt_t, không cần stack riêng. */
+#if (OS_CFG_PT)
+#define BUTTON_BLINK_TICKS      200u
+
+uint8_t Pt_ButtonLed(OsPt_t *pt)
+{
+    PT_BEGIN(pt);
+    for (;;) {
+        PT_WAIT_EVENT(pt, EVENT_BUTTON_PRESSED);
+        PtClearEvent(pt, EVENT_BUTTON_PRESSED);
+        ledA_toggle();
+        PT_DELAY(pt, BUTTON_BLINK_TICKS);
+        ledA_toggle();
+    }
+    PT_END(pt);
+}
+#endif
+
 /* Task_A: Blink LED PC13
- * - Mỗi ~100ms toggle 1 lần (điều chỉnh loop theo SystemCoreClock)
+ * - Nhịp do schedule table của chế độ hiện tại quyết định (150ms NORMAL,
+ *   50ms WARNING, không kích ở OFF) → task không cần biết chế độ
  * - Dùng SPL cho GPIO (đã bọc trong led_toggle())
  */
 void Task_A(void *arg)
 {
     (void)arg;
-    static uint16_t accA = 0, accB =0;
-    const uint16_t period_normal =150;
-    const uint16_t period_warn   =50;
-
-    switch (g_mode){
-        case MODE_NORMAL:
-            accA += 50;
-            if(accA == period_normal){
-                led_toggle();
-                accA=0;
-            }
-            break;
-        case MODE_WARNING:  
-            accB += 50;
-            if(accB == period_warn){
-                led_toggle();
-                accB=0;
-            }
-            break;
-        default:
-        GPIO_WriteBit(GPIOC, GPIO_Pin_13, 1);
-        accA = accB = 0;
-        break;
-    }
+    led_toggle();
     TerminateTask();
 }
 
+#define BUTTON_TIMEOUT_TICKS    3000u   /* 3 s @ OS_TICK_HZ = 1000 */
+
 /* Task_B: Gửi UART định kỳ
  * - Khung 115200-8-N-1
  * - Dùng polling TX cho đơn giản
@@ -190,12 +313,67 @@ void Task_B(void *arg)
 {
     (void)arg;
     EventMaskType ev;
-    WaitEvent(EVENT_BUTTON_PRESSED);
+    uint32_t presses;
+#if (OS_CFG_EVENTS)
+    /* Chờ nút / đổi chế độ tối đa 3 s (trong chu kỳ 5 s của schedule table) */
+    WaitEventTimeout(EVENT_BUTTON_PRESSED | EVENT_MODE_CHANGED, BUTTON_TIMEOUT_TICKS);
     GetEvent(g_current->id, &ev);
+    if (ev & EVENT_MODE_CHANGED){
+        LedState mode;
+        SignalRead(&g_mode_sig, &mode);
+        OS_LOG("[B] mode -> %u", mode);
+        ClearEvent(EVENT_MODE_CHANGED);
+    }
+    if (ev & OS_EVENT_TIMEOUT){
+        /* Không có nút nhấn trong cửa sổ chờ */
+        ClearEvent(OS_EVENT_TIMEOUT);
+    }
     if (ev & EVENT_BUTTON_PRESSED){
+        ClearEvent(EVENT_BUTTON_PRESSED);
+    }
+    /* Luôn rút kênh: nút nhấn lúc Task_B DORMANT không kèm event (IOC bỏ
+     * qua báo) nhưng vẫn nằm trong hàng đợi. LED do coroutine
+     * PT_BUTTON_LED đảm nhiệm; ở đây chỉ ghi số lần nhấn */
+    while (IocReceive(IOC_BUTTON, &presses) == IOC_E_OK) {
+#if !(OS_CFG_PT)
         ledA_toggle();
+#endif
+        OS_LOG("[B] button #%u", presses);
+    }
+#else
+    /* BCC1: không có event – mỗi lần kích hoạt thăm dò kênh IOC */
+    ev = 0u;
+    while (IocReceive(IOC_BUTTON, &presses) == IOC_E_OK) {
+        ledA_toggle();
+        OS_LOG("[B] button #%u", presses);
+    }
+#endif
+    OS_LOG("[B] Hello from Task_B, ev=0x%x", ev);
+#if (OS_CFG_ISR_LATENCY)
+    OsPerf_t lat;
+    GetIsrLatency(ISR_SYSTICK, &lat, 1u);
+    OS_LOG("[B] SysTick->dispatch cyc min=%u max=%u n=%u", lat.min, lat.max, lat.count);
+#endif
+#if (OS_CFG_TIMING_PROT)
+    /* Task_A/C đã dùng bao nhiêu so với ngân sách */
+    static const TaskType watched[] = { TASK_A, TASK_C };
+    OsTaskTimingStats_t tt;
+    for (uint8_t i = 0u; i < sizeof(watched); ++i) {
+        (void)GetTaskTiming(watched[i], &tt, 0u);
+        OS_LOG("[B] task %u exec max=%u / budget=%u cyc, overrun=%u early=%u",
+               watched[i], tt.exec_max, tt.budget, tt.overruns, tt.arrivals);
     }
-    //uart1_send_string("[UART] Hello from Task_B\r\n");
+#endif
+#if (OS_CFG_DEADLINE_MON)
+    uint32_t misses;
+    (void)GetDeadlineMisses(TASK_A, &misses, 0u);
+    OS_LOG("[B] Task_A deadline miss=%u", misses);
+#endif
+#if (OS_CFG_RR)
+    /* Số lần đổi task giữa chừng (cắt lượt + Schedule() + task timer):
+     * so sánh make IRES=0 (Task_B/C bị cắt lượt) với mặc định */
+    OS_LOG("[B] preempt=%u ires=%u", g_os_preempt, OS_CFG_IRES);
+#endif
 
     TerminateTask();
 
@@ -214,12 +392,28 @@ void Task_Init(void *arg)
     /* 1) LED PC13 */
     gpio_init_led();
 
-    /* 2) UART1 TX 115200 */
+    /* 2) UART1 TX 115200 (kênh ra của log nhị phân) */
+#if OS_CFG_LOG
+    uart1_init_115200();
+    OS_LOG("[BOOT] Peripherals initialized, core=%u Hz", SystemCoreClock);
+#else
     // uart1_init_115200();
     // uart1_send_string("[BOOT] Peripherals initialized.\r\n");
+#endif
     
     SetUpAlarm();
+#if (OS_CFG_SCHTBL)
     Setup_SchTbl();
+#else
+    /* Không có schedule table: LED theo alarm AID 0 (nhịp NORMAL cố định) */
+    SetRelAlarm(0u, 150u, 150u);
+#endif
+#ifdef APP_BENCH
+    Bench_Run();
+#else
+    SetRelAlarm(2u, 50u, 50u);          /* Task_C: thăm dò nút (chống dội 20 ms) */
+    SetRelAlarm(3u, 1000u, 1000u);      /* Task_D: CRC flash */
+#endif
     /* 3) Kết thúc task init (nhường CPU cho task khác) */
     TerminateTask();
 }
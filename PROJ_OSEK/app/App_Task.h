@@ -4,4 +4,5 @@ void Task_A(void *arg);
 void Task_B(void *arg);
 void Task_Idle(void *arg);
 void Task_C(void *arg);
+void Task_D(void *arg);
 
@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""
+Giải mã log nhị phân của OS_LOG (OS/inc/os_log.h) phía host.
+
+  - Đọc section .os_logstr trong ELF (Tools/os_test.elf): ID = địa chỉ chuỗi.
+  - Đọc luồng byte từ cổng serial / file / stdin ('-').
+  - Mỗi bản ghi: hdr (4 byte LE) = id<<16 | nargs<<8 | 0xA5, theo sau nargs word LE.
+
+Ví dụ:
+  python3 scripts/os_log_decode.py Tools/os_test.elf /dev/ttyUSB0
+  python3 scripts/os_log_decode.py Tools/os_test.elf capture.bin
+"""
+
+import re
+import struct
+import sys
+
+OS_LOG_COMMIT = 0xA5
+OS_LOG_MAX_ARGS = 8
+
+# printf của C → Python (chỉ hỗ trợ số nguyên, %c, %p)
+_SPEC = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|z|t)?([diuxXcop%])")
+
+
+def load_strings(elf_path):
+    """Trả về dict {id: chuỗi} lấy từ section .os_logstr."""
+    with open(elf_path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF" or elf[4] != 1:
+        raise SystemExit("%s: không phải ELF32" % elf_path)
+
+    e_shoff, = struct.unpack_from("<I", elf, 0x20)
+    e_shentsize, e_shnum, e_shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+
+    def shdr(i):
+        return struct.unpack_from("<IIIIIIIIII", elf, e_shoff + i * e_shentsize)
+
+    shstr = shdr(e_shstrndx)
+    names = elf[shstr[4]:shstr[4] + shstr[5]]
+
+    for i in range(e_shnum):
+        sh = shdr(i)
+        name = names[sh[0]:names.index(b"\0", sh[0])].decode()
+        if name != ".os_logstr":
+            continue
+        addr, off, size = sh[3], sh[4], sh[5]
+        data = elf[off:off + size]
+        table = {}
+        pos = 0
+        while pos < len(data):
+            end = data.index(b"\0", pos)
+            if end > pos:
+                table[(addr + pos) & 0xFFFF] = data[pos:end].decode("utf-8", "replace")
+            pos = end + 1
+        return table
+    raise SystemExit("%s: thiếu section .os_logstr (build với OS_CFG_LOG=1?)" % elf_path)
+
+
+def render(fmt, args):
+    """Thay từng %spec bằng tham số word tương ứng."""
+    it = iter(args)
+
+    def sub(m):
+        flags, conv = m.group(1), m.group(2)
+        if conv == "%":
+            return "%"
+        v = next(it, 0)
+        if conv in "di":
+            v = v - (1 << 32) if v & 0x80000000 else v
+            return ("%" + flags + "d") % v
+        if conv == "c":
+            return chr(v & 0xFF)
+        if conv == "p":
+            return "0x%08x" % v
+        return ("%" + flags + conv) % v
+
+    return _SPEC.sub(sub, fmt)
+
+
+def open_stream(src):
+    if src == "-":
+        return sys.stdin.buffer
+    if src.startswith("/dev/"):
+        try:
+            import serial  # pyserial (tuỳ chọn)
+            return serial.Serial(src, 115200, timeout=None)
+        except ImportError:
+            pass  # dùng stty ngoài: stty -F /dev/ttyUSB0 115200 raw
+    return open(src, "rb")
+
+
+def read_exact(stream, n):
+    buf = b""
+    while len(buf) < n:
+        chunk = stream.read(n - len(buf))
+        if not chunk:
+            return None
+        buf += chunk
+    return buf
+
+
+def main(argv):
+    if len(argv) != 3:
+        print(__doc__)
+        return 2
+    table = load_strings(argv[1])
+    stream = open_stream(argv[2])
+
+    while True:
+        b = read_exact(stream, 1)
+        if b is None:
+            return 0
+        if b[0] != OS_LOG_COMMIT:
+            continue                    # đồng bộ lại khung
+        rest = read_exact(stream, 3)
+        if rest is None:
+            return 0
+        nargs, lo, hi = rest[0] & 0x0F, rest[1], rest[2]
+        if nargs > OS_LOG_MAX_ARGS:
+            continue
+        log_id = lo | (hi << 8)
+        raw = read_exact(stream, 4 * nargs)
+        if raw is None:
+            return 0
+        args = struct.unpack("<%dI" % nargs, raw)
+        fmt = table.get(log_id)
+        if fmt is None:
+            print("<id 0x%04x chưa biết> %s" % (log_id, " ".join("0x%08x" % a for a in args)))
+        else:
+            print(render(fmt, args))
+        sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
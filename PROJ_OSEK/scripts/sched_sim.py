@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""
+Mô phỏng phía host: khả năng lập lịch của bộ task tuần hoàn tổng hợp
+với các chính sách READY của kernel (không preempt, run-to-completion).
+
+  - fifo : READY FIFO (OS_CFG_EDF = 0, mọi task dưới OS_PRIO_URGENT)
+  - fp   : ưu tiên cố định theo chu kỳ (rate-monotonic), không preempt
+  - edf  : deadline sớm nhất trước (OS_CFG_EDF = 1), deadline = chu kỳ
+
+Với mỗi mức tải U, sinh N bộ task (UUniFast), mô phỏng 1 siêu chu kỳ và
+in tỉ lệ bộ task không lỡ deadline nào. Chi phí dispatch đo trên target:
+BENCH_SCHED (make BENCH=1 so với make BENCH=1 EDF=1).
+
+Ví dụ:
+  python3 scripts/sched_sim.py
+  python3 scripts/sched_sim.py --tasks 8 --sets 500 --seed 7
+"""
+
+import argparse
+import heapq
+import random
+
+PERIODS = (10, 20, 25, 50, 100, 200)    # tick; siêu chu kỳ = 200
+HYPER = 200
+
+
+def uunifast(n, u, rng):
+    """Chia tổng tải u cho n task (Bini & Buttazzo)."""
+    out, rest = [], u
+    for i in range(1, n):
+        nxt = rest * rng.random() ** (1.0 / (n - i))
+        out.append(rest - nxt)
+        rest = nxt
+    out.append(rest)
+    return out
+
+
+def make_set(n, u, rng):
+    tasks = []
+    for ui in uunifast(n, u, rng):
+        t = rng.choice(PERIODS)
+        c = max(1, round(ui * t))
+        tasks.append((c, t))
+    return tasks
+
+
+def key_of(policy, job, tasks):
+    release, deadline, tid, seq = job
+    if policy == "edf":
+        return (deadline, seq)
+    if policy == "fp":
+        return (tasks[tid][1], seq)     # chu kỳ ngắn = ưu tiên cao
+    return (seq,)                       # fifo: theo thứ tự vào READY
+
+
+def simulate(tasks, policy):
+    """True nếu không job nào kết thúc sau deadline trong 1 siêu chu kỳ."""
+    releases = []
+    for tid, (c, t) in enumerate(tasks):
+        for r in range(0, HYPER, t):
+            releases.append((r, r + t, tid))
+    releases.sort()
+
+    ready, now, i, seq = [], 0, 0, 0
+    while i < len(releases) or ready:
+        while i < len(releases) and releases[i][0] <= now:
+            r, d, tid = releases[i]
+            job = (r, d, tid, seq)
+            heapq.heappush(ready, (key_of(policy, job, tasks), job))
+            seq += 1
+            i += 1
+        if not ready:
+            now = releases[i][0]        # CPU rỗi → IDLE tới lần kích hoạt kế
+            continue
+        _, (r, d, tid, _) = heapq.heappop(ready)
+        now += tasks[tid][0]            # chạy tới hết (không preempt)
+        if now > d:
+            return False
+    return True
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    ap.add_argument("--tasks", type=int, default=5)
+    ap.add_argument("--sets", type=int, default=300)
+    ap.add_argument("--seed", type=int, default=1)
+    args = ap.parse_args()
+
+    rng = random.Random(args.seed)
+    policies = ("fifo", "fp", "edf")
+    print("U     " + "  ".join("%6s" % p for p in policies))
+    for u10 in range(3, 11):
+        u = u10 / 10.0
+        ok = dict.fromkeys(policies, 0)
+        for _ in range(args.sets):
+            ts = make_set(args.tasks, u, rng)
+            for p in policies:
+                ok[p] += simulate(ts, p)
+        print("%.1f   " % u + "  ".join("%5.1f%%" % (100.0 * ok[p] / args.sets) for p in policies))
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())